@@ -0,0 +1,378 @@
+#include "../simpline/Simpline.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Result
+{
+	std::string type;
+	size_t pointCount;
+	std::string benchmark;
+	size_t operationCount;
+	double throughput;
+	double medianLatency;
+	double p90Latency;
+	double p99Latency;
+	long processPeakRss;
+};
+
+struct Options
+{
+	size_t maximumPointCount = 1000000;
+	size_t queryCount = 100000;
+	std::string format = "csv";
+	std::string outputFileName;
+	std::string baselineFileName;
+	double regressionThreshold = 1.25;
+};
+
+// accumulates query results so that the compiler cannot discard the benchmarked calls
+volatile double sink = 0;
+
+// same as the default tolerance of the constant-speed splines
+const double parameterValueTolerance = 1e-4;
+
+const size_t batchCount = 10;
+
+// batches of operations timed for the latencies last at least a microsecond, up to 64 operations
+const double minimumLatencyBatchTime = 1e-6;
+
+const size_t maximumLatencyBatchSize = 64;
+
+long getProcessPeakRss()
+{
+	// resident set size in kilobytes on Linux, the peak is the one of the whole process so far and not of the benchmark alone, point counts are
+	// increasing so that it mostly follows the largest case run so far
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+double getPercentile(const std::vector<double>& sortedLatencies, const double& percentile)
+{
+	return sortedLatencies[std::min(sortedLatencies.size() - 1, size_t(percentile * sortedLatencies.size()))];
+}
+
+// median time between two consecutive readings of the clock, in nanoseconds, which is subtracted from the timed batches of operations
+double measureClockOverhead()
+{
+	std::vector<double> overheads(10000);
+	for(double& overhead: overheads)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		overhead = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+	std::sort(overheads.begin(), overheads.end());
+	return getPercentile(overheads, 0.5);
+}
+
+const double clockOverhead = measureClockOverhead();
+
+// throughput (operations per second) is timed over a single loop of all the operations, then the operations are run again in batches timed
+// separately for the latencies (nanoseconds), batches being long enough for the clock overhead to be small next to them, so that latencies are
+// the mean of a few consecutive operations for the fastest ones
+Result measure(const std::string& type, const size_t& pointCount, const std::string& benchmark, const size_t& operationCount,
+			   const std::function<void(const size_t&)>& operation)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for(size_t i = 0; i < operationCount; i++)
+	{
+		operation(i);
+	}
+	const double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	const double throughput = operationCount / totalTime;
+	
+	const size_t latencyBatchSize = std::max<size_t>(1, std::min<size_t>(maximumLatencyBatchSize, size_t(minimumLatencyBatchTime * throughput)));
+	std::vector<double> latencies;
+	for(size_t i = 0; i < operationCount; i += latencyBatchSize)
+	{
+		const size_t batchEnd = std::min(i + latencyBatchSize, operationCount);
+		const auto batchStart = std::chrono::steady_clock::now();
+		for(size_t j = i; j < batchEnd; j++)
+		{
+			operation(j);
+		}
+		const double batchTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - batchStart).count();
+		latencies.push_back(std::max(0.0, batchTime - clockOverhead) / (batchEnd - i));
+	}
+	std::sort(latencies.begin(), latencies.end());
+	
+	return {type, pointCount, benchmark, operationCount, throughput, getPercentile(latencies, 0.5), getPercentile(latencies, 0.9),
+			getPercentile(latencies, 0.99), getProcessPeakRss()};
+}
+
+template<typename T>
+void runBenchmarks(const std::string& type, const size_t& pointCount, const Options& options, SimplineThreadPool& threadPool,
+				   std::vector<Result>& results)
+{
+	typedef typename simpline<T>::Vector Vector;
+	
+	// random walk with steps long enough for the accumulated chord lengths of a million float points to stay distinct
+	std::mt19937 generator(pointCount);
+	std::uniform_real_distribution<T> directionDistribution(-1, 1);
+	std::uniform_real_distribution<T> stepDistribution(0.5, 1.5);
+	std::vector<T> parameterValues(pointCount);
+	std::vector<Vector> points(pointCount);
+	points[0] = Vector::Zero();
+	for(size_t i = 0; i < pointCount; i++)
+	{
+		parameterValues[i] = i;
+		if(i > 0)
+		{
+			const Vector direction(directionDistribution(generator), directionDistribution(generator), directionDistribution(generator));
+			points[i] = points[i - 1] + stepDistribution(generator) * direction.normalized();
+		}
+	}
+	
+	// constructions are repeated until about as many points as queries are processed
+	const size_t constructionCount = std::max<size_t>(1, std::min<size_t>(1000, options.queryCount / pointCount));
+	typename simpline<T>::ParametrizedSpline parametrizedSpline;
+	results.push_back(measure(type, pointCount, "ParametrizedSpline construction", constructionCount, [&](const size_t&)
+	{
+		parametrizedSpline = typename simpline<T>::ParametrizedSpline(parameterValues, points);
+	}));
+	typename simpline<T>::ConstantSpeedSpline constantSpeedSpline;
+	results.push_back(measure(type, pointCount, "ConstantSpeedSpline construction", constructionCount, [&](const size_t&)
+	{
+		constantSpeedSpline = typename simpline<T>::ConstantSpeedSpline(points, 1);
+	}));
+	results.push_back(measure(type, pointCount, "ConstantSpeedSpline construction (thread pool)", constructionCount, [&](const size_t&)
+	{
+		constantSpeedSpline = typename simpline<T>::ConstantSpeedSpline(points, 1, parameterValueTolerance, typename simpline<T>::Quadrature(), threadPool);
+	}));
+	
+	const T maximumParameterValue = parameterValues[pointCount - 1];
+	const T length = parametrizedSpline.getLength();
+	std::uniform_real_distribution<T> unitDistribution(0, 1);
+	std::vector<T> randomFractions(options.queryCount);
+	std::vector<T> sequentialFractions(options.queryCount);
+	for(size_t i = 0; i < options.queryCount; i++)
+	{
+		randomFractions[i] = unitDistribution(generator);
+		sequentialFractions[i] = T(i) / options.queryCount;
+	}
+	
+	results.push_back(measure(type, pointCount, "random getValue", options.queryCount, [&](const size_t& i)
+	{
+		sink = sink + parametrizedSpline.getValue(randomFractions[i] * maximumParameterValue)[0];
+	}));
+	typename simpline<T>::SplineCursor valueCursor;
+	results.push_back(measure(type, pointCount, "sequential getValue", options.queryCount, [&](const size_t& i)
+	{
+		sink = sink + parametrizedSpline.getValue(sequentialFractions[i] * maximumParameterValue, valueCursor)[0];
+	}));
+	results.push_back(measure(type, pointCount, "random getGradient", options.queryCount, [&](const size_t& i)
+	{
+		sink = sink + parametrizedSpline.getGradient(randomFractions[i] * maximumParameterValue)[0];
+	}));
+	typename simpline<T>::SplineCursor gradientCursor;
+	results.push_back(measure(type, pointCount, "sequential getGradient", options.queryCount, [&](const size_t& i)
+	{
+		sink = sink + parametrizedSpline.getGradient(sequentialFractions[i] * maximumParameterValue, gradientCursor)[0];
+	}));
+	results.push_back(measure(type, pointCount, "random getLength", options.queryCount, [&](const size_t& i)
+	{
+		const T firstParameterValue = randomFractions[i] * maximumParameterValue;
+		const T secondParameterValue = randomFractions[options.queryCount - 1 - i] * maximumParameterValue;
+		sink = sink + parametrizedSpline.getLength(std::min(firstParameterValue, secondParameterValue), std::max(firstParameterValue, secondParameterValue));
+	}));
+	results.push_back(measure(type, pointCount, "random getParameterValue", options.queryCount, [&](const size_t& i)
+	{
+		sink = sink + parametrizedSpline.getParameterValue(randomFractions[i] * length, parameterValueTolerance);
+	}));
+	typename simpline<T>::SplineCursor parameterValueCursor;
+	results.push_back(measure(type, pointCount, "sequential getParameterValue", options.queryCount, [&](const size_t& i)
+	{
+		sink = sink + parametrizedSpline.getParameterValue(sequentialFractions[i] * length, parameterValueTolerance, parameterValueCursor);
+	}));
+	
+	// constant-speed queries go through the arc length inversion
+	const T duration = constantSpeedSpline.getDuration();
+	results.push_back(measure(type, pointCount, "random ConstantSpeedSpline getValue", options.queryCount, [&](const size_t& i)
+	{
+		sink = sink + constantSpeedSpline.getValue(randomFractions[i] * duration)[0];
+	}));
+	typename simpline<T>::SplineCursor timeCursor;
+	results.push_back(measure(type, pointCount, "sequential ConstantSpeedSpline getValue", options.queryCount, [&](const size_t& i)
+	{
+		sink = sink + constantSpeedSpline.getValue(sequentialFractions[i] * duration, timeCursor)[0];
+	}));
+	
+	// each operation of the batch benchmarks evaluates all the queries
+	std::vector<T> times(options.queryCount);
+	std::vector<T> values(Vector::RowsAtCompileTime * options.queryCount);
+	for(size_t i = 0; i < options.queryCount; i++)
+	{
+		times[i] = sequentialFractions[i] * duration;
+	}
+	results.push_back(measure(type, pointCount, "ConstantSpeedSpline evaluate batch", batchCount, [&](const size_t&)
+	{
+		constantSpeedSpline.evaluate(times.data(), options.queryCount, values.data(), nullptr);
+		sink = sink + values[0];
+	}));
+	results.push_back(measure(type, pointCount, "ConstantSpeedSpline evaluate batch (thread pool)", batchCount, [&](const size_t&)
+	{
+		constantSpeedSpline.evaluate(times.data(), options.queryCount, values.data(), nullptr, threadPool);
+		sink = sink + values[0];
+	}));
+}
+
+void writeCsv(std::ostream& stream, const std::vector<Result>& results)
+{
+	stream << "type,pointCount,benchmark,operationCount,throughput,medianLatency,p90Latency,p99Latency,processPeakRss" << std::endl;
+	for(const Result& result: results)
+	{
+		stream << result.type << "," << result.pointCount << "," << result.benchmark << "," << result.operationCount << "," << result.throughput << "," <<
+			   result.medianLatency << "," << result.p90Latency << "," << result.p99Latency << "," << result.processPeakRss << std::endl;
+	}
+}
+
+void writeJson(std::ostream& stream, const std::vector<Result>& results)
+{
+	stream << "[" << std::endl;
+	for(size_t i = 0; i < results.size(); i++)
+	{
+		stream << "  {\"type\": \"" << results[i].type << "\", \"pointCount\": " << results[i].pointCount << ", \"benchmark\": \"" << results[i].benchmark <<
+			   "\", \"operationCount\": " << results[i].operationCount << ", \"throughput\": " << results[i].throughput << ", \"medianLatency\": " <<
+			   results[i].medianLatency << ", \"p90Latency\": " << results[i].p90Latency << ", \"p99Latency\": " << results[i].p99Latency <<
+			   ", \"processPeakRss\": " << results[i].processPeakRss << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+	}
+	stream << "]" << std::endl;
+}
+
+// baselines are CSV files written by a previous run, benchmarks whose throughput dropped by more than the threshold are reported as regressions
+size_t compareWithBaseline(const std::vector<Result>& results, const Options& options)
+{
+	std::ifstream baselineFile(options.baselineFileName);
+	if(!baselineFile)
+	{
+		throw std::runtime_error("Cannot open baseline file " + options.baselineFileName + ".");
+	}
+	
+	std::map<std::string, double> baselineThroughputs;
+	std::string line;
+	std::getline(baselineFile, line);
+	while(std::getline(baselineFile, line))
+	{
+		std::vector<std::string> fields;
+		std::stringstream lineStream(line);
+		std::string field;
+		while(std::getline(lineStream, field, ','))
+		{
+			fields.push_back(field);
+		}
+		if(fields.size() == 9)
+		{
+			baselineThroughputs[fields[0] + "," + fields[1] + "," + fields[2]] = std::stod(fields[4]);
+		}
+	}
+	
+	size_t regressionCount = 0;
+	for(const Result& result: results)
+	{
+		const auto baselineThroughput = baselineThroughputs.find(result.type + "," + std::to_string(result.pointCount) + "," + result.benchmark);
+		if(baselineThroughput != baselineThroughputs.end() && baselineThroughput->second > result.throughput * options.regressionThreshold)
+		{
+			std::cerr << "Regression: " << result.type << " " << result.benchmark << " with " << result.pointCount << " points went from " <<
+					  baselineThroughput->second << " to " << result.throughput << " operations per second." << std::endl;
+			regressionCount++;
+		}
+	}
+	
+	return regressionCount;
+}
+
+void printUsage(const char* programName)
+{
+	std::cerr << "Usage: " << programName << " [--max-points N] [--queries N] [--format csv|json] [--output FILE] [--baseline FILE] [--threshold RATIO]" <<
+			  std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	for(int i = 1; i < argc; i++)
+	{
+		if(i + 1 >= argc)
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+		
+		if(std::strcmp(argv[i], "--max-points") == 0)
+		{
+			options.maximumPointCount = std::stoul(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--queries") == 0)
+		{
+			options.queryCount = std::stoul(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--format") == 0)
+		{
+			options.format = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--output") == 0)
+		{
+			options.outputFileName = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--baseline") == 0)
+		{
+			options.baselineFileName = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--threshold") == 0)
+		{
+			options.regressionThreshold = std::stod(argv[++i]);
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	
+	if((options.format != "csv" && options.format != "json") || options.queryCount == 0)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+	
+	SimplineThreadPool threadPool;
+	std::vector<Result> results;
+	for(size_t pointCount = 10; pointCount <= options.maximumPointCount; pointCount *= 10)
+	{
+		runBenchmarks<float>("float", pointCount, options, threadPool, results);
+		runBenchmarks<double>("double", pointCount, options, threadPool, results);
+	}
+	
+	std::ofstream outputFile;
+	if(!options.outputFileName.empty())
+	{
+		outputFile.open(options.outputFileName);
+	}
+	std::ostream& output = options.outputFileName.empty() ? std::cout : outputFile;
+	if(options.format == "csv")
+	{
+		writeCsv(output, results);
+	}
+	else
+	{
+		writeJson(output, results);
+	}
+	
+	if(!options.baselineFileName.empty() && compareWithBaseline(results, options) > 0)
+	{
+		return 2;
+	}
+	
+	return 0;
+}
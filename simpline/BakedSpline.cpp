@@ -0,0 +1,13 @@
+#include "BakedSplineImpl.h"
+
+template class simpline<float, 2>::BakedSpline;
+
+template class simpline<float, 3>::BakedSpline;
+
+template class simpline<float, 6>::BakedSpline;
+
+template class simpline<double, 2>::BakedSpline;
+
+template class simpline<double, 3>::BakedSpline;
+
+template class simpline<double, 6>::BakedSpline;
@@ -0,0 +1,294 @@
+#ifndef SIMPLINE_BAKED_SPLINE_IMPL_H
+#define SIMPLINE_BAKED_SPLINE_IMPL_H
+
+#include "Simpline.h"
+#include "Constants.h"
+#include "ParametrizedSplineImpl.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+template<typename T, int Dim>
+simpline<T, Dim>::BakedSpline::BakedSpline():
+		timeStep(), inverseTimeStep(), duration(), maximumError(), maximumGradientError()
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::BakedSpline::BakedSpline(const ConstantSpeedSpline& spline, const T& tolerance):
+		BakedSpline(spline, tolerance, nullptr)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::BakedSpline::BakedSpline(const ConstantSpeedSpline& spline, const T& tolerance, ThreadPool& threadPool):
+		BakedSpline(spline, tolerance, &threadPool)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::BakedSpline::BakedSpline(const ConstantSpeedSpline& spline, const T& tolerance, ThreadPool* threadPool):
+		BakedSpline()
+{
+	if(spline.parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot bake empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	if(tolerance <= 0)
+	{
+		throw std::runtime_error("Tolerance must be above 0!");
+	}
+	
+	duration = spline.duration;
+	size_t intervalCount = spline.parametrizedSpline.parameterValues.size() - 1;
+	size_t previousIntervalCount = 0;
+	T previousError = 0;
+	while(true)
+	{
+		sample(spline, intervalCount, threadPool);
+		measureError(spline, threadPool);
+		if(maximumError <= tolerance)
+		{
+			break;
+		}
+		
+		// the error of cubic Hermite interpolation decreases with the fourth power of the time step, but fresh evaluations of the spline are only as
+		// accurate as its tolerance, below which the error stops decreasing, tolerances needing more intervals than the maximum even at the fourth
+		// power are rejected before building grids that cannot meet them
+		const T refinement = std::pow(maximumError / tolerance, T(0.25));
+		const bool stalled = previousIntervalCount > 0 && !(std::log(previousError / maximumError) >=
+															simplineInternal::minimumBakingConvergenceOrder * std::log(T(intervalCount) / previousIntervalCount));
+		if(stalled || intervalCount * refinement > simplineInternal::maximumBakedIntervalCount)
+		{
+			std::ostringstream message;
+			message << "Baking tolerance of " << tolerance << " cannot be reached, the error is " << maximumError << " with " << intervalCount <<
+					" intervals.";
+			throw std::runtime_error(message.str());
+		}
+		previousIntervalCount = intervalCount;
+		previousError = maximumError;
+		
+		// the refinement is rounded up so that the next grid is likely to be the last one, and bounded since the error of coarse grids, measured at
+		// a few points per interval, is a poor estimate
+		intervalCount = std::min(intervalCount * std::min<size_t>(std::max<T>(std::ceil(refinement), 2), 16), simplineInternal::maximumBakedIntervalCount);
+	}
+	intervals.shrink_to_fit();
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::BakedSpline::sample(const ConstantSpeedSpline& spline, const size_t& intervalCount, ThreadPool* threadPool)
+{
+	timeStep = duration / intervalCount;
+	inverseTimeStep = intervalCount / duration;
+	
+	std::vector<T> times(intervalCount + 1);
+	for(size_t i = 0; i < intervalCount; i++)
+	{
+		times[i] = i * timeStep;
+	}
+	times[intervalCount] = duration;
+	
+	std::vector<T> values;
+	std::vector<T> gradients;
+	evaluateSamples(spline, times, values, gradients, threadPool);
+	
+	intervals.resize(intervalCount);
+	for(size_t i = 0; i < intervalCount; i++)
+	{
+		const Eigen::Map<const simpline<T, Dim>::Vector> startValue(values.data() + Dim * i);
+		const Eigen::Map<const simpline<T, Dim>::Vector> endValue(values.data() + Dim * (i + 1));
+		const Eigen::Map<const simpline<T, Dim>::Vector> startGradient(gradients.data() + Dim * i);
+		const Eigen::Map<const simpline<T, Dim>::Vector> endGradient(gradients.data() + Dim * (i + 1));
+		const T intervalLength = times[i + 1] - times[i];
+		const simpline<T, Dim>::Vector slope = (endValue - startValue) / intervalLength;
+		intervals[i].col(0) = startValue;
+		intervals[i].col(1) = startGradient;
+		intervals[i].col(2) = (3 * slope - 2 * startGradient - endGradient) / intervalLength;
+		intervals[i].col(3) = (startGradient + endGradient - 2 * slope) / (intervalLength * intervalLength);
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::BakedSpline::measureError(const ConstantSpeedSpline& spline, ThreadPool* threadPool)
+{
+	// the error of the values peaks in the middle of the intervals and the error of the gradients around their quarters
+	const T sampleFractions[3] = { 0.25, 0.5, 0.75 };
+	std::vector<T> times(3 * intervals.size());
+	for(size_t i = 0; i < intervals.size(); i++)
+	{
+		for(size_t j = 0; j < 3; j++)
+		{
+			times[3 * i + j] = std::min((i + sampleFractions[j]) * timeStep, duration);
+		}
+	}
+	
+	std::vector<T> values;
+	std::vector<T> gradients;
+	evaluateSamples(spline, times, values, gradients, threadPool);
+	
+	maximumError = 0;
+	maximumGradientError = 0;
+	for(size_t i = 0; i < times.size(); i++)
+	{
+		const SegmentCoefficients& coefficients = intervals[i / 3];
+		const T localTime = times[i] - (i / 3) * timeStep;
+		const Eigen::Map<const simpline<T, Dim>::Vector> value(values.data() + Dim * i);
+		const Eigen::Map<const simpline<T, Dim>::Vector> gradient(gradients.data() + Dim * i);
+		maximumError = std::max<T>(maximumError, (simplineInternal::computeSegmentValue(coefficients, localTime) - value).norm());
+		maximumGradientError = std::max<T>(maximumGradientError, (simplineInternal::computeSegmentGradient(coefficients, localTime) - gradient).norm());
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::BakedSpline::evaluateSamples(const ConstantSpeedSpline& spline, const std::vector<T>& times, std::vector<T>& values,
+												   std::vector<T>& gradients, ThreadPool* threadPool)
+{
+	// every sample is evaluated with its own cursor, as a fresh evaluation of the spline would be, so that neither the interpolation nor its error
+	// depend on the warm starts of the arc length inversion
+	values.resize(Dim * times.size());
+	gradients.resize(Dim * times.size());
+	const auto evaluateRange = [&](const size_t& first, const size_t& last)
+	{
+		for(size_t i = first; i < last; i++)
+		{
+			SplineCursor cursor;
+			spline.evaluate(&times[i], 1, values.data() + Dim * i, gradients.data() + Dim * i, cursor);
+		}
+	};
+	if(threadPool)
+	{
+		threadPool->parallelFor(times.size(), simplineInternal::parallelChunkSize, evaluateRange);
+	}
+	else
+	{
+		evaluateRange(0, times.size());
+	}
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::BakedSpline::findIntervalIndex(const T& time) const
+{
+	// the end of the spline belongs to the last interval
+	return std::min(static_cast<size_t>(time * inverseTimeStep), intervals.size() - 1);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::BakedSpline::getValue(const T& time) const
+{
+	if(intervals.empty())
+	{
+		throw std::runtime_error("Cannot get value from empty baked spline. Use non-default constructor to provide a spline.");
+	}
+	
+	if(time < 0.0 || time > duration)
+	{
+		throw std::runtime_error("Value requested at time=" + std::to_string(time) + ". Time must be between 0.0 and " + std::to_string(duration) + ".");
+	}
+	
+	const size_t intervalIndex = findIntervalIndex(time);
+	return simplineInternal::computeSegmentValue(intervals[intervalIndex], T(time - intervalIndex * timeStep));
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::BakedSpline::getGradient(const T& time) const
+{
+	if(intervals.empty())
+	{
+		throw std::runtime_error("Cannot get gradient from empty baked spline. Use non-default constructor to provide a spline.");
+	}
+	
+	if(time < 0.0 || time > duration)
+	{
+		throw std::runtime_error("Gradient requested at time=" + std::to_string(time) + ". Time must be between 0.0 and " + std::to_string(duration) + ".");
+	}
+	
+	const size_t intervalIndex = findIntervalIndex(time);
+	return simplineInternal::computeSegmentGradient(intervals[intervalIndex], T(time - intervalIndex * timeStep));
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::BakedSpline::evaluate(const T* times, const size_t& count, T* values, T* gradients) const
+{
+	if(intervals.empty())
+	{
+		throw std::runtime_error("Cannot evaluate empty baked spline. Use non-default constructor to provide a spline.");
+	}
+	
+	for(size_t i = 0; i < count; i++)
+	{
+		const T& time = times[i];
+		if(time < 0.0 || time > duration)
+		{
+			throw std::runtime_error("Evaluation requested at time=" + std::to_string(time) + ". Time must be between 0.0 and " + std::to_string(duration) + ".");
+		}
+		
+		const size_t intervalIndex = findIntervalIndex(time);
+		const T localTime = time - intervalIndex * timeStep;
+		if(values)
+		{
+			Eigen::Map<simpline<T, Dim>::Vector> value(values + Dim * i);
+			value = simplineInternal::computeSegmentValue(intervals[intervalIndex], localTime);
+		}
+		if(gradients)
+		{
+			Eigen::Map<simpline<T, Dim>::Vector> gradient(gradients + Dim * i);
+			gradient = simplineInternal::computeSegmentGradient(intervals[intervalIndex], localTime);
+		}
+	}
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::BakedSpline::getDuration() const
+{
+	if(intervals.empty())
+	{
+		throw std::runtime_error("Cannot get duration of empty baked spline. Use non-default constructor to provide a spline.");
+	}
+	
+	return duration;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::BakedSpline::getTimeStep() const
+{
+	if(intervals.empty())
+	{
+		throw std::runtime_error("Cannot get time step of empty baked spline. Use non-default constructor to provide a spline.");
+	}
+	
+	return timeStep;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::BakedSpline::getMaximumError() const
+{
+	if(intervals.empty())
+	{
+		throw std::runtime_error("Cannot get error of empty baked spline. Use non-default constructor to provide a spline.");
+	}
+	
+	return maximumError;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::BakedSpline::getMaximumGradientError() const
+{
+	if(intervals.empty())
+	{
+		throw std::runtime_error("Cannot get error of empty baked spline. Use non-default constructor to provide a spline.");
+	}
+	
+	return maximumGradientError;
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::BakedSpline::getMemoryUsage() const
+{
+	return intervals.capacity() * sizeof(SegmentCoefficients);
+}
+
+#endif
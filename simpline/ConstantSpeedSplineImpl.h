@@ -0,0 +1,698 @@
+#ifndef SIMPLINE_CONSTANT_SPEED_SPLINE_IMPL_H
+#define SIMPLINE_CONSTANT_SPEED_SPLINE_IMPL_H
+
+#include "Simpline.h"
+#include "Constants.h"
+#include "ParametrizedSplineImpl.h"
+#include "Serialization.h"
+#include "Statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+template<typename T, int Dim>
+simpline<T, Dim>::ConstantSpeedSpline::Sampler::Sampler(const ConstantSpeedSpline& spline, const T& timeStep):
+		spline(&spline), timeStep(timeStep), sampleIndex(0), cursor()
+{
+	if(spline.parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot sample empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	if(timeStep <= 0)
+	{
+		throw std::runtime_error("Time step must be above 0!");
+	}
+}
+
+template<typename T, int Dim>
+bool simpline<T, Dim>::ConstantSpeedSpline::Sampler::next(State& state, const bool& withFrenetFrame)
+{
+	// time is recomputed from the sample index rather than accumulated to avoid drifting
+	const T time = getTime();
+	if(time > spline->duration)
+	{
+		return false;
+	}
+	
+	state = spline->evaluateState(time, cursor, withFrenetFrame);
+	sampleIndex++;
+	
+	return true;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ConstantSpeedSpline::Sampler::getTime() const
+{
+	return sampleIndex * timeStep;
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ConstantSpeedSpline::ConstantSpeedSpline()
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ConstantSpeedSpline::ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed):
+		ConstantSpeedSpline(points, speed, simplineInternal::epsilon)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ConstantSpeedSpline::ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance):
+		ConstantSpeedSpline(points, speed, tolerance, Quadrature())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ConstantSpeedSpline::ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance,
+														   const Quadrature& quadrature):
+		ConstantSpeedSpline(points, speed, tolerance, quadrature, nullptr, std::pmr::get_default_resource())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ConstantSpeedSpline::ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance,
+														   const Quadrature& quadrature, ThreadPool& threadPool):
+		ConstantSpeedSpline(points, speed, tolerance, quadrature, &threadPool, std::pmr::get_default_resource())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ConstantSpeedSpline::ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance,
+														   const Quadrature& quadrature, std::pmr::memory_resource* memoryResource):
+		ConstantSpeedSpline(points, speed, tolerance, quadrature, nullptr, memoryResource)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ConstantSpeedSpline::ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance,
+														   const Quadrature& quadrature, ThreadPool* threadPool, std::pmr::memory_resource* memoryResource):
+		parametrizedSpline(), speed(speed), duration(), tolerance(tolerance)
+{
+	if(points.size() < 2)
+	{
+		throw std::runtime_error("Point list must contain at least two items!");
+	}
+	
+	if(speed <= 0)
+	{
+		throw std::runtime_error("Speed must be above 0!");
+	}
+	
+	if(tolerance <= 0)
+	{
+		throw std::runtime_error("Tolerance must be above 0!");
+	}
+	
+	std::vector<T> parameterValues = { 0 };
+	{
+		SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "parametrize", &Statistics::parametrizationTime);
+		
+		for(size_t i = 1; i < points.size(); i++)
+		{
+			parameterValues.push_back(parameterValues[i - 1] + (points[i] - points[i - 1]).norm());
+		}
+	}
+	parametrizedSpline = ParametrizedSpline(KnotBasis(parameterValues), points, quadrature, threadPool, memoryResource);
+	
+	duration = parametrizedSpline.getLength() / speed;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ConstantSpeedSpline::getValue(const T& time) const
+{
+	SplineCursor cursor;
+	return getValue(time, cursor);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ConstantSpeedSpline::getValue(const T& time, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "getValue", nullptr);
+	
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get value from empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	if(time < 0.0 || time > duration)
+	{
+		throw std::runtime_error("Value requested at time=" + std::to_string(time) + ". Time must be between 0.0 and " + std::to_string(duration) + ".");
+	}
+	
+	return parametrizedSpline.getValue(computeParameterValue(time, cursor), cursor);
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ConstantSpeedSpline::computeParameterValue(const T& time, SplineCursor& cursor) const noexcept
+{
+	// time is proportional to arc length, which can slightly exceed the spline length at the end of the spline because of rounding
+	const simplineInternal::MappableVector<T>& cumulativeLengths = parametrizedSpline.cumulativeLengths;
+	const T length = std::min(time * speed, cumulativeLengths[cumulativeLengths.size() - 1]);
+	cursor.segmentIndex = simplineInternal::findIntervalIndex(cumulativeLengths, length, cursor.segmentIndex);
+	return simplineInternal::invertSegmentLength(parametrizedSpline.segments.data(), parametrizedSpline.parameterValues.data(), cumulativeLengths.data(),
+												 cursor.segmentIndex, parametrizedSpline.quadrature, length, tolerance, cursor.anchorSegmentIndex,
+												 cursor.anchorParameterValue, cursor.anchorLength);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ConstantSpeedSpline::getGradient(const T& time) const
+{
+	SplineCursor cursor;
+	return getGradient(time, cursor);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ConstantSpeedSpline::getGradient(const T& time, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "getGradient", nullptr);
+	
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get gradient from empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	if(time < 0.0 || time > duration)
+	{
+		throw std::runtime_error("Gradient requested at time=" + std::to_string(time) + ". Time must be between 0.0 and " + std::to_string(duration) + ".");
+	}
+	
+	return parametrizedSpline.getGradient(computeParameterValue(time, cursor), cursor).normalized() * speed;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::evaluate(const T* times, const size_t& count, T* values, T* gradients) const
+{
+	SplineCursor cursor;
+	evaluate(times, count, values, gradients, cursor);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::evaluate(const T* times, const size_t& count, T* values, T* gradients, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "evaluate", nullptr);
+	
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot evaluate empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	T parameterValues[simplineInternal::evaluationBlockSize];
+	for(size_t blockStartIndex = 0; blockStartIndex < count; blockStartIndex += simplineInternal::evaluationBlockSize)
+	{
+		if(blockStartIndex > 0 && blockStartIndex % simplineInternal::parallelChunkSize == 0)
+		{
+			cursor = SplineCursor();
+		}
+		
+		const size_t blockSize = std::min(simplineInternal::evaluationBlockSize, count - blockStartIndex);
+		for(size_t i = 0; i < blockSize; i++)
+		{
+			const T& time = times[blockStartIndex + i];
+			if(time < 0.0 || time > duration)
+			{
+				throw std::runtime_error("Evaluation requested at time=" + std::to_string(time) + ". Time must be between 0.0 and " + std::to_string(duration) + ".");
+			}
+			parameterValues[i] = computeParameterValue(time, cursor);
+		}
+		
+		T* blockGradients = gradients ? gradients + Dim * blockStartIndex : nullptr;
+		parametrizedSpline.evaluate(parameterValues, blockSize, values ? values + Dim * blockStartIndex : nullptr, blockGradients, cursor);
+		
+		if(blockGradients)
+		{
+			for(size_t i = 0; i < blockSize; i++)
+			{
+				Eigen::Map<simpline<T, Dim>::Vector> gradient(blockGradients + Dim * i);
+				gradient = gradient.normalized() * speed;
+			}
+		}
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::evaluate(const T* times, const size_t& count, T* values, T* gradients, ThreadPool& threadPool) const
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot evaluate empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	threadPool.parallelFor(count, simplineInternal::parallelChunkSize, [&](const size_t& first, const size_t& last)
+	{
+		SplineCursor cursor;
+		evaluate(times + first, last - first, values ? values + Dim * first : nullptr, gradients ? gradients + Dim * first : nullptr, cursor);
+	});
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::State simpline<T, Dim>::ConstantSpeedSpline::evaluateState(const T& time, const bool& withFrenetFrame) const
+{
+	SplineCursor cursor;
+	return evaluateState(time, cursor, withFrenetFrame);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::State simpline<T, Dim>::ConstantSpeedSpline::evaluateState(const T& time, SplineCursor& cursor, const bool& withFrenetFrame) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "evaluateState", nullptr);
+	
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot evaluate state of empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	if(time < 0.0 || time > duration)
+	{
+		throw std::runtime_error("State requested at time=" + std::to_string(time) + ". Time must be between 0.0 and " + std::to_string(duration) + ".");
+	}
+	
+	State state = parametrizedSpline.evaluateState(computeParameterValue(time, cursor), cursor, withFrenetFrame);
+	convertState(state);
+	
+	return state;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::ConstantSpeedSpline::tryGetValue(const T& time, simpline<T, Dim>::Vector& value,
+																					  SplineCursor& cursor) const noexcept
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "tryGetValue", nullptr);
+	
+	T clampedTime;
+	const Status status = clampTime(time, clampedTime);
+	if(status != SUCCESS && status != CLAMPED)
+	{
+		return status;
+	}
+	
+	const T parameterValue = computeParameterValue(clampedTime, cursor);
+	parametrizedSpline.tryGetValue(parameterValue, value, cursor);
+	return status;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::ConstantSpeedSpline::tryGetGradient(const T& time, simpline<T, Dim>::Vector& gradient,
+																						 SplineCursor& cursor) const noexcept
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "tryGetGradient", nullptr);
+	
+	T clampedTime;
+	const Status status = clampTime(time, clampedTime);
+	if(status != SUCCESS && status != CLAMPED)
+	{
+		return status;
+	}
+	
+	const T parameterValue = computeParameterValue(clampedTime, cursor);
+	parametrizedSpline.tryGetGradient(parameterValue, gradient, cursor);
+	gradient = gradient.normalized() * speed;
+	return status;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::ConstantSpeedSpline::tryEvaluateState(const T& time, State& state, SplineCursor& cursor,
+																						   const bool& withFrenetFrame) const noexcept
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "tryEvaluateState", nullptr);
+	
+	T clampedTime;
+	const Status status = clampTime(time, clampedTime);
+	if(status != SUCCESS && status != CLAMPED)
+	{
+		return status;
+	}
+	
+	const T parameterValue = computeParameterValue(clampedTime, cursor);
+	parametrizedSpline.tryEvaluateState(parameterValue, state, cursor, withFrenetFrame);
+	convertState(state);
+	return status;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::convertState(State& state) const noexcept
+{
+	// derivatives with respect to the parameter value are converted to time derivatives with du/dt = speed / |dp/du|
+	const simpline<T, Dim>::Vector tangent = state.velocity.normalized();
+	const T squaredGradientNorm = state.velocity.squaredNorm();
+	state.acceleration = (speed * speed / squaredGradientNorm) * (state.acceleration - tangent * tangent.dot(state.acceleration));
+	state.velocity = tangent * speed;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::ConstantSpeedSpline::clampTime(const T& time, T& clampedTime) const noexcept
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		return EMPTY_SPLINE;
+	}
+	
+	if(std::isnan(time))
+	{
+		return INVALID_ARGUMENT;
+	}
+	
+	if(time < 0.0 || time > duration)
+	{
+		clampedTime = time < 0.0 ? T(0) : duration;
+		return CLAMPED;
+	}
+	
+	clampedTime = time;
+	return SUCCESS;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::evaluateStates(const T* times, const size_t& count, State* states, const bool& withFrenetFrame) const
+{
+	SplineCursor cursor;
+	evaluateStates(times, count, states, cursor, withFrenetFrame);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::evaluateStates(const T* times, const size_t& count, State* states, SplineCursor& cursor,
+													  const bool& withFrenetFrame) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "evaluateStates", nullptr);
+	
+	for(size_t i = 0; i < count; i++)
+	{
+		if(i > 0 && i % simplineInternal::parallelChunkSize == 0)
+		{
+			cursor = SplineCursor();
+		}
+		states[i] = evaluateState(times[i], cursor, withFrenetFrame);
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::evaluateStates(const T* times, const size_t& count, State* states, ThreadPool& threadPool,
+													  const bool& withFrenetFrame) const
+{
+	threadPool.parallelFor(count, simplineInternal::parallelChunkSize, [&](const size_t& first, const size_t& last)
+	{
+		SplineCursor cursor;
+		evaluateStates(times + first, last - first, states + first, cursor, withFrenetFrame);
+	});
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::appendPoints(const std::vector<simpline<T, Dim>::Vector>& points)
+{
+	appendPoints(points, simplineInternal::defaultDecayTolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::appendPoints(const std::vector<simpline<T, Dim>::Vector>& points, const T& decayTolerance)
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot append points to empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	std::vector<T> parameterValues(points.size());
+	{
+		SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "parametrize", &Statistics::parametrizationTime);
+		
+		for(size_t i = 0; i < points.size(); i++)
+		{
+			const T& previousParameterValue = i > 0 ? parameterValues[i - 1] : parametrizedSpline.parameterValues[parametrizedSpline.parameterValues.size() - 1];
+			const simpline<T, Dim>::Vector previousPoint = i > 0 ? points[i - 1] : simpline<T, Dim>::Vector(parametrizedSpline.segments.back().col(0));
+			const T chordLength = (points[i] - previousPoint).norm();
+			if(chordLength == 0)
+			{
+				throw std::runtime_error("Multiple points cannot have the same parameter value.");
+			}
+			parameterValues[i] = previousParameterValue + chordLength;
+		}
+	}
+	// the parametrized spline validates the decay tolerance and the parameter values before changing anything
+	parametrizedSpline.appendPoints(parameterValues, points, decayTolerance);
+	
+	duration = parametrizedSpline.getLength() / speed;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::movePoint(const size_t& pointIndex, const simpline<T, Dim>::Vector& newPoint)
+{
+	replaceRange(pointIndex, std::vector<simpline<T, Dim>::Vector>(1, newPoint), simplineInternal::defaultDecayTolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::movePoint(const size_t& pointIndex, const simpline<T, Dim>::Vector& newPoint, const T& decayTolerance)
+{
+	replaceRange(pointIndex, std::vector<simpline<T, Dim>::Vector>(1, newPoint), decayTolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::replaceRange(const size_t& firstPointIndex, const std::vector<simpline<T, Dim>::Vector>& newPoints)
+{
+	replaceRange(firstPointIndex, newPoints, simplineInternal::defaultDecayTolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::replaceRange(const size_t& firstPointIndex, const std::vector<simpline<T, Dim>::Vector>& newPoints,
+													const T& decayTolerance)
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot replace points of empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	simplineInternal::MappableVector<T>& parameterValues = parametrizedSpline.parameterValues;
+	simplineInternal::MappableVector<SegmentCoefficients>& segments = parametrizedSpline.segments;
+	// the sum of the index and the number of points could overflow
+	if(newPoints.size() == 0 || firstPointIndex > segments.size() || newPoints.size() > segments.size() - firstPointIndex)
+	{
+		throw std::runtime_error("Replacement of points " + std::to_string(firstPointIndex) + " to " + std::to_string(firstPointIndex + newPoints.size()) +
+								 " requested. Point indices must be between 0 and " + std::to_string(segments.size() - 1) + ".");
+	}
+	
+	// everything is validated before the points are replaced, so that the spline is left as it was when they are rejected
+	const size_t windowSize = simplineInternal::computeWindowSize(decayTolerance);
+	
+	// chord lengths change for the segments around the replaced points
+	const size_t lastPointIndex = firstPointIndex + newPoints.size() - 1;
+	const size_t lastShiftedPointIndex = std::min(lastPointIndex + 1, segments.size() - 1);
+	const size_t firstShiftedPointIndex = std::max<size_t>(firstPointIndex, 1);
+	std::vector<T> chordLengths(lastShiftedPointIndex + 1 - firstShiftedPointIndex);
+	for(size_t i = firstShiftedPointIndex; i <= lastShiftedPointIndex; i++)
+	{
+		const simpline<T, Dim>::Vector point = i <= lastPointIndex ? newPoints[i - firstPointIndex] : simpline<T, Dim>::Vector(segments[i].col(0));
+		const simpline<T, Dim>::Vector previousPoint = i - 1 >= firstPointIndex ? newPoints[i - 1 - firstPointIndex] :
+													   simpline<T, Dim>::Vector(segments[i - 1].col(0));
+		chordLengths[i - firstShiftedPointIndex] = (point - previousPoint).norm();
+		if(chordLengths[i - firstShiftedPointIndex] == 0)
+		{
+			throw std::runtime_error("Multiple points cannot have the same parameter value.");
+		}
+		
+		if(!std::isfinite(chordLengths[i - firstShiftedPointIndex]))
+		{
+			throw std::runtime_error("Points must be finite!");
+		}
+	}
+	
+	for(size_t i = 0; i < newPoints.size(); i++)
+	{
+		segments[firstPointIndex + i].col(0) = newPoints[i];
+	}
+	const T previousParameterValue = parameterValues[lastShiftedPointIndex];
+	for(size_t i = firstShiftedPointIndex; i <= lastShiftedPointIndex; i++)
+	{
+		parameterValues[i] = parameterValues[i - 1] + chordLengths[i - firstShiftedPointIndex];
+	}
+	const T parameterValueShift = parameterValues[lastShiftedPointIndex] - previousParameterValue;
+	for(size_t i = lastShiftedPointIndex + 1; i < parameterValues.size(); i++)
+	{
+		parameterValues[i] += parameterValueShift;
+	}
+	
+	parametrizedSpline.solveWindow(firstPointIndex > 0 ? firstPointIndex - 1 : 0, lastShiftedPointIndex, windowSize);
+	
+	duration = parametrizedSpline.getLength() / speed;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ConstantSpeedSpline::getLength() const
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get length of empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	return duration * speed;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ConstantSpeedSpline::getLengthErrorEstimate() const
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get length of empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	return parametrizedSpline.getLengthErrorEstimate();
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ConstantSpeedSpline::getLength(const T& startTime, const T& endTime) const
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get length of empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	if(startTime > endTime)
+	{
+		throw std::runtime_error("Length requested from time=" + std::to_string(startTime) + " to time=" + std::to_string(endTime) +
+								 ". End time must be greater or equal to start time.");
+	}
+	
+	if(startTime < 0.0 || endTime > duration)
+	{
+		throw std::runtime_error("Length requested from time=" + std::to_string(startTime) + " to time=" + std::to_string(endTime) +
+								 ". Time must be between 0.0 and " + std::to_string(duration) + ".");
+	}
+	
+	return (endTime - startTime) * speed;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ConstantSpeedSpline::getSpeed() const
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get speed of empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	return speed;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ConstantSpeedSpline::getDuration() const
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get duration of empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	return duration;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::ConstantSpeedSpline::Sampler simpline<T, Dim>::ConstantSpeedSpline::sampler(const T& timeStep) const
+{
+	return Sampler(*this, timeStep);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Projection simpline<T, Dim>::ConstantSpeedSpline::project(const simpline<T, Dim>::Vector& point) const
+{
+	SplineCursor cursor;
+	return project(point, cursor);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Projection simpline<T, Dim>::ConstantSpeedSpline::project(const simpline<T, Dim>::Vector& point, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "project", nullptr);
+	
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot project on empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	Projection projection = parametrizedSpline.project(point, cursor);
+	projection.time = computeProjectionTime(projection.parameterValue, cursor);
+	return projection;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ConstantSpeedSpline::computeProjectionTime(const T& parameterValue, SplineCursor& cursor) const
+{
+	// the time is the arc length up to the closest point, which only needs to be integrated from the start of its segment
+	const size_t segmentIndex = parametrizedSpline.findSegmentIndex(parameterValue, cursor);
+	cursor.segmentIndex = segmentIndex;
+	T errorEstimate;
+	const T length = parametrizedSpline.cumulativeLengths[segmentIndex] +
+					 parametrizedSpline.integrateLength(segmentIndex, parametrizedSpline.parameterValues[segmentIndex], parameterValue, errorEstimate);
+	return std::min(length / speed, duration);
+}
+
+template<typename T, int Dim>
+bool simpline<T, Dim>::ConstantSpeedSpline::projectNearLength(const simpline<T, Dim>::Vector& point, const T& length, Projection& projection) const
+{
+	const simplineInternal::MappableVector<T>& cumulativeLengths = parametrizedSpline.cumulativeLengths;
+	const simplineInternal::MappableVector<T>& parameterValues = parametrizedSpline.parameterValues;
+	const size_t segmentCount = cumulativeLengths.size() - 1;
+	const T clampedLength = std::min(std::max(length, T(0)), cumulativeLengths[segmentCount]);
+	const size_t segmentIndex = simplineInternal::findIntervalIndex(cumulativeLengths, clampedLength, segmentCount);
+	const size_t firstSegmentIndex = segmentIndex - std::min(segmentIndex, simplineInternal::replanProjectionWindowSegmentCount);
+	const size_t lastSegmentIndex = std::min(segmentIndex + simplineInternal::replanProjectionWindowSegmentCount, segmentCount - 1);
+	
+	T squaredDistance;
+	SplineCursor cursor;
+	cursor.segmentIndex = parametrizedSpline.projectOnSegments(point, firstSegmentIndex, lastSegmentIndex, projection.parameterValue, squaredDistance);
+	projection.point = parametrizedSpline.computeValue(cursor.segmentIndex, projection.parameterValue);
+	projection.distance = std::sqrt(squaredDistance);
+	projection.time = computeProjectionTime(projection.parameterValue, cursor);
+	
+	// the ends of the segments are rounded when they are offset from the start of their segment
+	const T startParameterValue = parameterValues[firstSegmentIndex];
+	const T endParameterValue = parameterValues[lastSegmentIndex + 1];
+	const T endTolerance = 4 * std::numeric_limits<T>::epsilon() * (std::abs(startParameterValue) + std::abs(endParameterValue));
+	return !((firstSegmentIndex > 0 && projection.parameterValue <= startParameterValue + endTolerance) ||
+			 (lastSegmentIndex + 1 < segmentCount && projection.parameterValue >= endParameterValue - endTolerance));
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::save(const std::string& fileName) const
+{
+	parametrizedSpline.write(fileName, simplineInternal::CONSTANT_SPEED_SPLINE_FILE, speed, duration, tolerance);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::ConstantSpeedSpline simpline<T, Dim>::ConstantSpeedSpline::load(const std::string& fileName)
+{
+	ConstantSpeedSpline spline;
+	spline.parametrizedSpline = ParametrizedSpline::read(fileName, simplineInternal::CONSTANT_SPEED_SPLINE_FILE, spline.speed, spline.duration,
+														 spline.tolerance);
+	return spline;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::validate() const
+{
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot validate empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	// speed, duration and tolerance are checked by load()
+	parametrizedSpline.validate();
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Statistics simpline<T, Dim>::ConstantSpeedSpline::getStatistics() const
+{
+	Statistics statistics = parametrizedSpline.getStatistics();
+#ifdef SIMPLINE_ENABLE_STATISTICS
+	statistics += statisticsRecorder.getStatistics();
+#endif
+	return statistics;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ConstantSpeedSpline::setTraceCallback(const TraceCallback& traceCallback)
+{
+	parametrizedSpline.setTraceCallback(traceCallback);
+#ifdef SIMPLINE_ENABLE_STATISTICS
+	statisticsRecorder.setTraceCallback(traceCallback);
+#endif
+}
+
+#endif
@@ -1,9 +1,107 @@
 #ifndef SIMPLINE_CONSTANTS_H
 #define SIMPLINE_CONSTANTS_H
 
-const double epsilon = 1e-4;
+#include <array>
+#include <cstddef>
 
-const std::vector<double> gaussianQuadratureAbcissa = {
+namespace simplineInternal
+{
+constexpr double epsilon = 1e-4;
+
+constexpr size_t evaluationBlockSize = 64;
+
+constexpr size_t maximumRootFindingIterations = 64;
+
+constexpr double secondDerivativeDecayRate = 0.5;
+
+constexpr double defaultDecayTolerance = 1e-6;
+
+constexpr size_t maximumQuadratureDepth = 10;
+
+// multiple of the evaluation block size, chunk boundaries do not depend on the number of threads so that results do not either
+constexpr size_t parallelChunkSize = 1024;
+
+// consecutive segments bounded by each box of the first level of the bounding volume hierarchy
+constexpr size_t boundingVolumeLeafSize = 8;
+
+// segments searched on each side of the arc length of the readers when a spline handle projects them on a new version
+constexpr size_t replanProjectionWindowSegmentCount = 8;
+
+// bounds the memory of baked splines, tolerances that would need more intervals are rejected
+constexpr size_t maximumBakedIntervalCount = 1 << 20;
+
+// order of the decrease of the error of baked splines with their time step below which the error is deemed to have stopped decreasing, such as
+// for tolerances below the accuracy of the arc length inversion
+constexpr double minimumBakingConvergenceOrder = 0.5;
+
+constexpr std::array<double, 5> gaussianQuadratureAbcissa5 = {
+		0.0000000000000000,
+		-0.5384693101056831,
+		0.5384693101056831,
+		-0.9061798459386640,
+		0.9061798459386640
+};
+
+constexpr std::array<double, 5> gaussianQuadratureWeights5 = {
+		0.5688888888888889,
+		0.4786286704993665,
+		0.4786286704993665,
+		0.2369268850561891,
+		0.2369268850561891
+};
+
+constexpr std::array<double, 7> gaussianQuadratureAbcissa7 = {
+		0.0000000000000000,
+		-0.4058451513773972,
+		0.4058451513773972,
+		-0.7415311855993945,
+		0.7415311855993945,
+		-0.9491079123427585,
+		0.9491079123427585
+};
+
+constexpr std::array<double, 7> gaussianQuadratureWeights7 = {
+		0.4179591836734694,
+		0.3818300505051189,
+		0.3818300505051189,
+		0.2797053914892767,
+		0.2797053914892767,
+		0.1294849661688697,
+		0.1294849661688697
+};
+
+// 15-point Kronrod extension of the 7-point Gauss rule, taken from QUADPACK, only positive abcissae are listed with the center last
+constexpr std::array<double, 8> gaussKronrodAbcissa = {
+		0.9914553711208126,
+		0.9491079123427585,
+		0.8648644233597691,
+		0.7415311855993945,
+		0.5860872354676911,
+		0.4058451513773972,
+		0.2077849550078985,
+		0.0000000000000000
+};
+
+constexpr std::array<double, 8> gaussKronrodWeights = {
+		0.0229353220105292,
+		0.0630920926299786,
+		0.1047900103222502,
+		0.1406532597155259,
+		0.1690047266392679,
+		0.1903505780647854,
+		0.2044329400752989,
+		0.2094821410847278
+};
+
+// weights of the 7-point Gauss rule, whose abcissae are the odd ones of the Kronrod rule
+constexpr std::array<double, 4> gaussKronrodGaussWeights = {
+		0.1294849661688697,
+		0.2797053914892767,
+		0.3818300505051189,
+		0.4179591836734694
+};
+
+constexpr std::array<double, 25> gaussianQuadratureAbcissa = {
 		0.0000000000000000,
 		-0.1228646926107104,
 		0.1228646926107104,
@@ -31,7 +129,7 @@ const std::vector<double> gaussianQuadratureAbcissa = {
 		0.9955569697904981
 };
 
-const std::vector<double> gaussianQuadratureWeights = {
+constexpr std::array<double, 25> gaussianQuadratureWeights = {
 		0.1231760537267154,
 		0.1222424429903100,
 		0.1222424429903100,
@@ -58,5 +156,6 @@ const std::vector<double> gaussianQuadratureWeights = {
 		0.0113937985010263,
 		0.0113937985010263
 };
+}
 
 #endif
@@ -0,0 +1,225 @@
+#ifndef SIMPLINE_MAPPABLE_VECTOR_H
+#define SIMPLINE_MAPPABLE_VECTOR_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace simplineInternal
+{
+constexpr size_t cacheLineSize = 64;
+
+// allocator drawing from a caller-supplied memory resource, which follows the spline when it is moved but not when it is copied, so that copies do not
+// depend on the lifetime of the resource
+template<typename Element>
+class ResourceAllocator
+{
+public:
+	typedef Element value_type;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+	
+	ResourceAllocator() noexcept:
+			memoryResource(std::pmr::get_default_resource())
+	{
+	}
+	
+	ResourceAllocator(std::pmr::memory_resource* memoryResource) noexcept:
+			memoryResource(memoryResource)
+	{
+	}
+	
+	template<typename OtherElement>
+	ResourceAllocator(const ResourceAllocator<OtherElement>& other) noexcept:
+			memoryResource(other.memoryResource)
+	{
+	}
+	
+	// elements start on a cache line, as in mapped files, so that a record of segment coefficients spans as few lines as its size allows: the 96
+	// bytes of three-dimensional doubles always span two lines instead of up to three, and padding them to 128 bytes would still span two
+	Element* allocate(const size_t& count)
+	{
+		return static_cast<Element*>(memoryResource->allocate(count * sizeof(Element), alignment));
+	}
+	
+	void deallocate(Element* elements, const size_t& count) noexcept
+	{
+		memoryResource->deallocate(elements, count * sizeof(Element), alignment);
+	}
+	
+	ResourceAllocator select_on_container_copy_construction() const
+	{
+		return ResourceAllocator();
+	}
+	
+	template<typename OtherElement>
+	bool operator==(const ResourceAllocator<OtherElement>& other) const noexcept
+	{
+		return *memoryResource == *other.memoryResource;
+	}
+	
+	template<typename OtherElement>
+	bool operator!=(const ResourceAllocator<OtherElement>& other) const noexcept
+	{
+		return !(*this == other);
+	}
+	
+	std::pmr::memory_resource* memoryResource;
+
+private:
+	static constexpr size_t alignment = alignof(Element) > cacheLineSize ? alignof(Element) : cacheLineSize;
+};
+
+// owned elements starting on a cache line
+template<typename Element>
+using AlignedVector = std::vector<Element, ResourceAllocator<Element>>;
+
+// vector whose elements are either owned or read from a memory mapping kept alive by the vector, mapped elements are copied before the first
+// modification so that mappings are never written to
+template<typename Element>
+class MappableVector
+{
+public:
+	typedef Element value_type;
+	
+	MappableVector():
+			view(nullptr), count(0)
+	{
+	}
+	
+	explicit MappableVector(const size_t& size, const Element& value = Element(),
+							std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource()):
+			elements(size, value, ResourceAllocator<Element>(memoryResource)), view(elements.data()), count(size)
+	{
+	}
+	
+	MappableVector(const Element* mappedElements, const size_t& size, const std::shared_ptr<const void>& mapping):
+			view(mappedElements), count(size), mapping(mapping)
+	{
+	}
+	
+	MappableVector(const MappableVector& other):
+			elements(other.elements), view(other.mapping ? other.view : elements.data()), count(other.count), mapping(other.mapping)
+	{
+	}
+	
+	MappableVector(MappableVector&& other) noexcept:
+			elements(std::move(other.elements)), view(other.mapping ? other.view : elements.data()), count(other.count), mapping(std::move(other.mapping))
+	{
+		other.view = nullptr;
+		other.count = 0;
+	}
+	
+	MappableVector& operator=(const MappableVector& other)
+	{
+		if(this != &other)
+		{
+			elements = other.elements;
+			mapping = other.mapping;
+			view = mapping ? other.view : elements.data();
+			count = other.count;
+		}
+		return *this;
+	}
+	
+	MappableVector& operator=(MappableVector&& other) noexcept
+	{
+		elements = std::move(other.elements);
+		mapping = std::move(other.mapping);
+		view = mapping ? other.view : elements.data();
+		count = other.count;
+		other.view = nullptr;
+		other.count = 0;
+		return *this;
+	}
+	
+	size_t size() const
+	{
+		return count;
+	}
+	
+	bool empty() const
+	{
+		return count == 0;
+	}
+	
+	bool isMapped() const
+	{
+		return mapping != nullptr;
+	}
+	
+	const Element* data() const
+	{
+		return view;
+	}
+	
+	const Element* begin() const
+	{
+		return view;
+	}
+	
+	const Element* end() const
+	{
+		return view + count;
+	}
+	
+	const Element& operator[](const size_t& index) const
+	{
+		return view[index];
+	}
+	
+	Element& operator[](const size_t& index)
+	{
+		detach();
+		return elements[index];
+	}
+	
+	const Element& back() const
+	{
+		return view[count - 1];
+	}
+	
+	Element& back()
+	{
+		detach();
+		return elements.back();
+	}
+	
+	void resize(const size_t& size)
+	{
+		detach();
+		elements.resize(size);
+		view = elements.data();
+		count = elements.size();
+	}
+	
+	void push_back(const Element& element)
+	{
+		detach();
+		elements.push_back(element);
+		view = elements.data();
+		count = elements.size();
+	}
+
+private:
+	void detach()
+	{
+		if(mapping)
+		{
+			elements.assign(view, view + count);
+			mapping.reset();
+			view = elements.data();
+		}
+	}
+	
+	std::vector<Element, ResourceAllocator<Element>> elements;
+	// points to the owned elements or to the mapping
+	const Element* view;
+	size_t count;
+	std::shared_ptr<const void> mapping;
+};
+}
+
+#endif
@@ -0,0 +1,1843 @@
+#ifndef SIMPLINE_PARAMETRIZED_SPLINE_IMPL_H
+#define SIMPLINE_PARAMETRIZED_SPLINE_IMPL_H
+
+#include "Simpline.h"
+#include "Constants.h"
+#include "Serialization.h"
+#include "Statistics.h"
+#include "StatisticsImpl.h"
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace simplineInternal
+{
+// taken from https://stackoverflow.com/questions/1577475/c-sorting-and-keeping-track-of-indexes
+template<typename T>
+std::vector<size_t> sortIndices(const std::vector<T>& unsortedVector)
+{
+	std::vector<size_t> sortedIndices(unsortedVector.size());
+	std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
+	std::sort(sortedIndices.begin(), sortedIndices.end(), [&unsortedVector](size_t i1, size_t i2){ return unsortedVector[i1] < unsortedVector[i2]; });
+	return sortedIndices;
+}
+
+// right-hand side of the natural spline equation of a point between two others
+template<typename T, typename Vector>
+Vector computeSecondDerivativeRightHandSide(const Vector& previousPoint, const Vector& point, const Vector& nextPoint, const T& previousIntervalLength,
+											const T& nextIntervalLength)
+{
+	return 6 * ((nextPoint - point) / nextIntervalLength - (point - previousPoint) / previousIntervalLength) / (previousIntervalLength + nextIntervalLength);
+}
+
+// Thomas algorithm, the system must be diagonally dominant (which is the case for spline systems) for the factorization to be stable
+template<typename T>
+void factorizeTridiagonalSystem(const std::vector<T>& lowerDiagonal, const std::vector<T>& diagonal, const std::vector<T>& upperDiagonal,
+								std::vector<T>& upperFactors, std::vector<T>& inversePivots)
+{
+	upperFactors.resize(diagonal.size());
+	inversePivots.resize(diagonal.size());
+	
+	inversePivots[0] = 1.0 / diagonal[0];
+	upperFactors[0] = upperDiagonal[0] * inversePivots[0];
+	for(size_t i = 1; i < diagonal.size(); i++)
+	{
+		inversePivots[i] = 1.0 / (diagonal[i] - lowerDiagonal[i] * upperFactors[i - 1]);
+		upperFactors[i] = upperDiagonal[i] * inversePivots[i];
+	}
+}
+
+template<typename T, typename Vector>
+void solveTridiagonalSystem(const std::vector<T>& lowerDiagonal, const std::vector<T>& upperFactors, const std::vector<T>& inversePivots,
+							std::vector<Vector>& rightHandSides)
+{
+	// forward substitution
+	rightHandSides[0] = rightHandSides[0] * inversePivots[0];
+	for(size_t i = 1; i < rightHandSides.size(); i++)
+	{
+		rightHandSides[i] = (rightHandSides[i] - lowerDiagonal[i] * rightHandSides[i - 1]) * inversePivots[i];
+	}
+	
+	// back substitution
+	for(size_t i = rightHandSides.size() - 1; i > 0; i--)
+	{
+		rightHandSides[i - 1] = rightHandSides[i - 1] - upperFactors[i - 1] * rightHandSides[i];
+	}
+}
+
+// index of the interval [values[i], values[i + 1]) containing value, searching forward from hintIndex when it is valid
+template<typename T, typename Values>
+size_t findIntervalIndex(const Values& values, const T& value, const size_t& hintIndex)
+{
+	const size_t intervalCount = values.size() - 1;
+	SIMPLINE_COUNT(segmentSearchCount, 1);
+	if(hintIndex >= intervalCount || values[hintIndex] > value)
+	{
+		// the last value belongs to the last interval
+		SIMPLINE_COUNT(scannedSegmentCount, countBinarySearchComparisons(values.size()));
+		const size_t nextIndex = std::upper_bound(values.begin(), values.end(), value) - values.begin();
+		return std::min(std::max<size_t>(nextIndex, 1), intervalCount) - 1;
+	}
+	
+	// galloping search forward from the hint, which is amortized O(1) for increasing values
+	size_t lowerIndex = hintIndex;
+	size_t step = 1;
+	while(lowerIndex + step < intervalCount && values[lowerIndex + step] <= value)
+	{
+		SIMPLINE_COUNT(scannedSegmentCount, 1);
+		lowerIndex += step;
+		step *= 2;
+	}
+	const size_t upperIndex = std::min(lowerIndex + step, intervalCount);
+	SIMPLINE_COUNT(scannedSegmentCount, 1 + countBinarySearchComparisons(upperIndex - lowerIndex - 1));
+	
+	return std::upper_bound(values.begin() + lowerIndex + 1, values.begin() + upperIndex, value) - values.begin() - 1;
+}
+
+// perturbations of the second derivatives at one point of a natural spline system decay at least by half at each point away from it,
+// since every row has a diagonal of 2 and off-diagonal coefficients summing to 1
+template<typename T>
+size_t computeWindowSize(const T& decayTolerance)
+{
+	if(decayTolerance <= 0 || decayTolerance >= 1)
+	{
+		throw std::runtime_error("Decay tolerance must be between 0 and 1!");
+	}
+	
+	return std::ceil(std::log(decayTolerance) / std::log(secondDerivativeDecayRate));
+}
+
+// Gaussian quadrature, taken from https://medium.com/@all2one/how-to-compute-the-length-of-a-spline-e44f5f04c40
+template<typename T, size_t N, typename Integrand>
+T integrateGaussLegendre(const std::array<double, N>& abcissa, const std::array<double, N>& weights, const T& start, const T& end,
+						 const Integrand& integrand)
+{
+	T integral = 0.0;
+	const T intervalLength = end - start;
+	for(size_t i = 0; i < N; i++)
+	{
+		const T t = start + (((abcissa[i] + 1.0) / 2.0) * intervalLength); // Change of interval from [-1, 1]
+		integral += (intervalLength / 2.0) * integrand(t) * weights[i]; // Same for (intervalLength / 2.0)
+	}
+	
+	return integral;
+}
+
+// the difference between the Kronrod rule and the embedded Gauss rule is used as error estimate, it is pessimistic for smooth integrands
+template<typename T, typename Integrand>
+T integrateGaussKronrod(const T& start, const T& end, const Integrand& integrand, T& errorEstimate)
+{
+	const T center = (start + end) / 2.0;
+	const T halfIntervalLength = (end - start) / 2.0;
+	const T centerValue = integrand(center);
+	T kronrodIntegral = gaussKronrodWeights[gaussKronrodWeights.size() - 1] * centerValue;
+	T gaussIntegral = gaussKronrodGaussWeights[gaussKronrodGaussWeights.size() - 1] * centerValue;
+	for(size_t i = 0; i < gaussKronrodAbcissa.size() - 1; i++)
+	{
+		const T offset = halfIntervalLength * gaussKronrodAbcissa[i];
+		const T values = integrand(center - offset) + integrand(center + offset);
+		kronrodIntegral += gaussKronrodWeights[i] * values;
+		if(i % 2 == 1)
+		{
+			gaussIntegral += gaussKronrodGaussWeights[i / 2] * values;
+		}
+	}
+	
+	errorEstimate = std::abs((kronrodIntegral - gaussIntegral) * halfIntervalLength);
+	return kronrodIntegral * halfIntervalLength;
+}
+
+// intervals are bisected until their error estimate is below the tolerance, the absolute tolerance being split between both halves
+template<typename T, typename Integrand>
+T integrateAdaptively(const T& start, const T& end, const Integrand& integrand, const T& absoluteTolerance, const T& relativeTolerance,
+					  const size_t& depth, T& errorEstimate)
+{
+	const T integral = integrateGaussKronrod(start, end, integrand, errorEstimate);
+	if(errorEstimate <= std::max(absoluteTolerance, relativeTolerance * std::abs(integral)) || depth >= maximumQuadratureDepth)
+	{
+		return integral;
+	}
+	
+	const T middle = (start + end) / 2.0;
+	T firstErrorEstimate;
+	T secondErrorEstimate;
+	const T firstIntegral = integrateAdaptively(start, middle, integrand, absoluteTolerance / 2, relativeTolerance, depth + 1, firstErrorEstimate);
+	const T secondIntegral = integrateAdaptively(middle, end, integrand, absoluteTolerance / 2, relativeTolerance, depth + 1, secondErrorEstimate);
+	errorEstimate = firstErrorEstimate + secondErrorEstimate;
+	return firstIntegral + secondIntegral;
+}
+
+template<typename T, typename SegmentCoefficients>
+Eigen::Matrix<T, SegmentCoefficients::RowsAtCompileTime, 1> computeSegmentValue(const SegmentCoefficients& coefficients, const T& localParameterValue)
+{
+	return coefficients.col(0) +
+		   localParameterValue * (coefficients.col(1) + localParameterValue * (coefficients.col(2) + localParameterValue * coefficients.col(3)));
+}
+
+template<typename T, typename SegmentCoefficients>
+Eigen::Matrix<T, SegmentCoefficients::RowsAtCompileTime, 1> computeSegmentGradient(const SegmentCoefficients& coefficients, const T& localParameterValue)
+{
+	return coefficients.col(1) + localParameterValue * (2 * coefficients.col(2) + 3 * localParameterValue * coefficients.col(3));
+}
+
+template<typename T, typename SegmentCoefficients>
+Eigen::Matrix<T, SegmentCoefficients::RowsAtCompileTime, 1> computeSegmentSecondDerivative(const SegmentCoefficients& coefficients,
+																						   const T& localParameterValue)
+{
+	return 2 * coefficients.col(2) + 6 * localParameterValue * coefficients.col(3);
+}
+
+// roots in [0, end] of a polynomial of degree 5 given by its coefficients in increasing powers, the roots of each derivative split the interval in
+// pieces where the next lower derivative is monotonic, so that it has at most one root per piece, which is found by safeguarded Newton steps
+template<typename T>
+size_t findQuinticRoots(const T (&coefficients)[6], const T& end, T (&roots)[5])
+{
+	// derivatives[k] holds the coefficients of the k-th derivative, whose degree is 5 - k
+	T derivatives[6][6];
+	std::copy(coefficients, coefficients + 6, derivatives[0]);
+	for(size_t k = 1; k < 6; k++)
+	{
+		for(size_t i = 0; i + k < 6; i++)
+		{
+			derivatives[k][i] = (i + 1) * derivatives[k - 1][i + 1];
+		}
+	}
+	const auto evaluate = [&derivatives](const size_t& k, const T& x)
+	{
+		T value = derivatives[k][5 - k];
+		for(size_t i = 5 - k; i > 0; i--)
+		{
+			value = value * x + derivatives[k][i - 1];
+		}
+		return value;
+	};
+	
+	const T tolerance = std::numeric_limits<T>::epsilon() * end;
+	T criticalPoints[5];
+	size_t criticalPointCount = 0;
+	for(size_t k = 5; k > 0; k--)
+	{
+		// the roots of derivative k - 1, the fifth derivative is constant and splits nothing
+		T pieceRoots[5];
+		size_t pieceRootCount = 0;
+		T pieceStart = 0;
+		for(size_t i = 0; i <= criticalPointCount; i++)
+		{
+			const T pieceEnd = i < criticalPointCount ? criticalPoints[i] : end;
+			T lowerBound = pieceStart;
+			T upperBound = pieceEnd;
+			const T startValue = evaluate(k - 1, pieceStart);
+			const T endValue = evaluate(k - 1, pieceEnd);
+			pieceStart = pieceEnd;
+			if(startValue == 0)
+			{
+				if(pieceRootCount == 0 || pieceRoots[pieceRootCount - 1] != lowerBound)
+				{
+					pieceRoots[pieceRootCount++] = lowerBound;
+				}
+				continue;
+			}
+			
+			if(endValue != 0 && (startValue < 0) == (endValue < 0))
+			{
+				continue;
+			}
+			
+			const bool increasing = startValue < 0;
+			T x = (lowerBound + upperBound) / 2;
+			for(size_t j = 0; j < maximumRootFindingIterations; j++)
+			{
+				const T value = evaluate(k - 1, x);
+				if(value == 0)
+				{
+					break;
+				}
+				
+				if((value < 0) == increasing)
+				{
+					lowerBound = x;
+				}
+				else
+				{
+					upperBound = x;
+				}
+				
+				T nextX = x - value / evaluate(k, x);
+				if(!(nextX > lowerBound && nextX < upperBound))
+				{
+					nextX = (lowerBound + upperBound) / 2;
+				}
+				
+				const T step = std::abs(nextX - x);
+				x = nextX;
+				if(step <= tolerance || upperBound - lowerBound <= tolerance)
+				{
+					break;
+				}
+			}
+			pieceRoots[pieceRootCount++] = x;
+		}
+		std::copy(pieceRoots, pieceRoots + pieceRootCount, criticalPoints);
+		criticalPointCount = pieceRootCount;
+	}
+	
+	std::copy(criticalPoints, criticalPoints + criticalPointCount, roots);
+	return criticalPointCount;
+}
+
+// segments are integrated and inverted from their coefficients alone, so that splines sharing their arrays in a batch give the same results as
+// single ones
+template<typename T, typename SegmentCoefficients, typename Quadrature>
+T integrateSegmentLength(const SegmentCoefficients& coefficients, const T& segmentStartParameterValue, const Quadrature& quadrature,
+						 const T& startParameterValue, const T& endParameterValue, T& errorEstimate)
+{
+	const auto gradientNorm = [&coefficients, &segmentStartParameterValue](const T& parameterValue)
+	{
+		SIMPLINE_COUNT(gradientEvaluationCount, 1);
+		return computeSegmentGradient(coefficients, T(parameterValue - segmentStartParameterValue)).norm();
+	};
+	SIMPLINE_COUNT(quadratureCount, 1);
+	
+	switch(quadrature.rule)
+	{
+		case Quadrature::GAUSS_LEGENDRE_5:
+			errorEstimate = std::numeric_limits<T>::quiet_NaN();
+			return integrateGaussLegendre(gaussianQuadratureAbcissa5, gaussianQuadratureWeights5, startParameterValue, endParameterValue, gradientNorm);
+		case Quadrature::GAUSS_LEGENDRE_7:
+			errorEstimate = std::numeric_limits<T>::quiet_NaN();
+			return integrateGaussLegendre(gaussianQuadratureAbcissa7, gaussianQuadratureWeights7, startParameterValue, endParameterValue, gradientNorm);
+		case Quadrature::ADAPTIVE_GAUSS_KRONROD_15:
+			return integrateAdaptively(startParameterValue, endParameterValue, gradientNorm, quadrature.absoluteTolerance, quadrature.relativeTolerance, 0,
+									   errorEstimate);
+		default:
+			errorEstimate = std::numeric_limits<T>::quiet_NaN();
+			return integrateGaussLegendre(gaussianQuadratureAbcissa, gaussianQuadratureWeights, startParameterValue, endParameterValue, gradientNorm);
+	}
+}
+
+// parameter value at which the arc length reaches the wanted length within a segment, the anchor of the previous inversion is only used and updated
+// when the root is solved iteratively
+template<typename T, typename SegmentCoefficients, typename Quadrature>
+T invertSegmentLength(const SegmentCoefficients* segments, const T* parameterValues, const T* cumulativeLengths, const size_t& segmentIndex,
+					  const Quadrature& quadrature, const T& length, const T& tolerance, size_t& anchorSegmentIndex, T& anchorParameterValue,
+					  T& anchorLength)
+{
+	const SegmentCoefficients& coefficients = segments[segmentIndex];
+	const T wantedSegmentLength = length - cumulativeLengths[segmentIndex];
+	const T segmentLength = cumulativeLengths[segmentIndex + 1] - cumulativeLengths[segmentIndex];
+	if(wantedSegmentLength <= 0)
+	{
+		return parameterValues[segmentIndex];
+	}
+	if(wantedSegmentLength >= segmentLength)
+	{
+		return parameterValues[segmentIndex + 1];
+	}
+	
+	// Newton's method on the arc length, whose derivative is the norm of the gradient, starting from the previous inversion when it is in the same
+	// segment and from the start of the segment otherwise, iterates leaving the bracket containing the root are replaced by bisection steps
+	// lengths are always integrated from the start of the segment, so that warm started inversions solve the same equation as cold ones and the
+	// previous inversion only gives the initial guess and the lower bound of the bracket
+	T lowerBound = parameterValues[segmentIndex];
+	T upperBound = parameterValues[segmentIndex + 1];
+	T parameterValue = lowerBound + (wantedSegmentLength / segmentLength) * (upperBound - lowerBound);
+	if(anchorSegmentIndex == segmentIndex && anchorLength <= length)
+	{
+		lowerBound = anchorParameterValue;
+		
+		// second order Taylor expansion of the parameter value with respect to arc length, with du/ds = 1 / |p'| and d2u/ds2 = -(p' . p'') / |p'|^4
+		const T localParameterValue = anchorParameterValue - parameterValues[segmentIndex];
+		const Eigen::Matrix<T, SegmentCoefficients::RowsAtCompileTime, 1> gradient = computeSegmentGradient(coefficients, localParameterValue);
+		const T squaredGradientNorm = gradient.squaredNorm();
+		const T lengthStep = length - anchorLength;
+		parameterValue = anchorParameterValue + lengthStep / std::sqrt(squaredGradientNorm) -
+						 (lengthStep * lengthStep * gradient.dot(computeSegmentSecondDerivative(coefficients, localParameterValue))) /
+						 (2 * squaredGradientNorm * squaredGradientNorm);
+		if(!(parameterValue >= lowerBound && parameterValue < upperBound))
+		{
+			parameterValue = (lowerBound + upperBound) / 2;
+		}
+	}
+	
+	// the anchor is the last iterate whose arc length was integrated, with that length rather than the wanted one, so that the errors of successive
+	// inversions do not add up
+	T integratedParameterValue = parameterValue;
+	T integratedLength = length;
+	SIMPLINE_COUNT(rootFindingCount, 1);
+	for(size_t i = 0; i < maximumRootFindingIterations; i++)
+	{
+		SIMPLINE_COUNT(rootFindingIterationCount, 1);
+		T errorEstimate;
+		const T lengthError = integrateSegmentLength(coefficients, parameterValues[segmentIndex], quadrature, parameterValues[segmentIndex], parameterValue,
+													 errorEstimate) - wantedSegmentLength;
+		integratedParameterValue = parameterValue;
+		integratedLength = length + lengthError;
+		if(lengthError == 0)
+		{
+			break;
+		}
+		
+		if(lengthError < 0)
+		{
+			lowerBound = parameterValue;
+		}
+		else
+		{
+			upperBound = parameterValue;
+		}
+		
+		T nextParameterValue = parameterValue - lengthError / computeSegmentGradient(coefficients, T(parameterValue - parameterValues[segmentIndex])).norm();
+		
+		// a converged Newton step is kept even when rounding leaves it on the bound set by the current iterate, which happens when warm starts land
+		// on the root, instead of being replaced by a bisection step away from the root
+		if(std::abs(nextParameterValue - parameterValue) <= tolerance)
+		{
+			parameterValue = std::min(std::max(nextParameterValue, lowerBound), upperBound);
+			break;
+		}
+		
+		if(!(nextParameterValue > lowerBound && nextParameterValue < upperBound))
+		{
+			nextParameterValue = (lowerBound + upperBound) / 2;
+		}
+		
+		const T step = std::abs(nextParameterValue - parameterValue);
+		parameterValue = nextParameterValue;
+		if(step <= tolerance || upperBound - lowerBound <= tolerance)
+		{
+			break;
+		}
+	}
+	
+	anchorSegmentIndex = segmentIndex;
+	anchorParameterValue = integratedParameterValue;
+	anchorLength = integratedLength;
+	
+	return parameterValue;
+}
+
+// Horner evaluation of a cubic segment over a block of parameter values, each axis is a separate loop so that it can be vectorized
+template<typename T, typename SegmentCoefficients>
+void evaluateSegmentBlock(const T* localParameterValues, const size_t& count, const SegmentCoefficients& coefficients, T* values, T* gradients)
+{
+	T axisValues[evaluationBlockSize];
+	for(size_t i = 0; i < SegmentCoefficients::RowsAtCompileTime; i++)
+	{
+		if(values)
+		{
+			const T c0 = coefficients(i, 0);
+			const T c1 = coefficients(i, 1);
+			const T c2 = coefficients(i, 2);
+			const T c3 = coefficients(i, 3);
+			for(size_t j = 0; j < count; j++)
+			{
+				axisValues[j] = c0 + localParameterValues[j] * (c1 + localParameterValues[j] * (c2 + localParameterValues[j] * c3));
+			}
+			for(size_t j = 0; j < count; j++)
+			{
+				values[SegmentCoefficients::RowsAtCompileTime * j + i] = axisValues[j];
+			}
+		}
+		
+		if(gradients)
+		{
+			const T c1 = coefficients(i, 1);
+			const T c2 = 2 * coefficients(i, 2);
+			const T c3 = 3 * coefficients(i, 3);
+			for(size_t j = 0; j < count; j++)
+			{
+				axisValues[j] = c1 + localParameterValues[j] * (c2 + localParameterValues[j] * c3);
+			}
+			for(size_t j = 0; j < count; j++)
+			{
+				gradients[SegmentCoefficients::RowsAtCompileTime * j + i] = axisValues[j];
+			}
+		}
+	}
+}
+
+template<typename T>
+void computeBinormal(const Eigen::Matrix<T, 3, 1>& tangent, const Eigen::Matrix<T, 3, 1>& normal, Eigen::Matrix<T, 3, 1>& binormal)
+{
+	binormal = tangent.cross(normal);
+}
+
+// the binormal is only defined in three dimensions
+template<typename Vector>
+void computeBinormal(const Vector&, const Vector&, Vector&)
+{
+}
+
+// fills the curvature and the Frenet frame of a state from its first two derivatives, the component of the acceleration normal to the velocity is used
+// since it is the only one bending the curve
+template<typename T, typename State>
+void computeFrenetFrame(State& state)
+{
+	const T speed = state.velocity.norm();
+	if(speed == 0)
+	{
+		return;
+	}
+	
+	state.tangent = state.velocity / speed;
+	const auto normalAcceleration = state.acceleration - state.tangent * state.tangent.dot(state.acceleration);
+	const T normalAccelerationNorm = normalAcceleration.norm();
+	state.curvature = normalAccelerationNorm / (speed * speed);
+	if(normalAccelerationNorm == 0)
+	{
+		return;
+	}
+	
+	state.normal = normalAcceleration / normalAccelerationNorm;
+	computeBinormal(state.tangent, state.normal, state.binormal);
+}
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::SplineCursor::SplineCursor():
+		segmentIndex(std::numeric_limits<size_t>::max()), anchorSegmentIndex(std::numeric_limits<size_t>::max()), anchorParameterValue(),
+		anchorLength()
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline()
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T, Dim>::Vector>& points):
+		ParametrizedSpline(parameterValues, points, Quadrature())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T, Dim>::Vector>& points,
+														 const Quadrature& quadrature):
+		ParametrizedSpline(KnotBasis(parameterValues), points, quadrature, nullptr, std::pmr::get_default_resource())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T, Dim>::Vector>& points,
+														 const Quadrature& quadrature, ThreadPool& threadPool):
+		ParametrizedSpline(KnotBasis(parameterValues), points, quadrature, &threadPool, std::pmr::get_default_resource())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T, Dim>::Vector>& points,
+														 const Quadrature& quadrature, std::pmr::memory_resource* memoryResource):
+		ParametrizedSpline(KnotBasis(parameterValues), points, quadrature, nullptr, memoryResource)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points):
+		ParametrizedSpline(basis, points, Quadrature(), nullptr, std::pmr::get_default_resource())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points,
+														 const Quadrature& quadrature):
+		ParametrizedSpline(basis, points, quadrature, nullptr, std::pmr::get_default_resource())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points,
+														 const Quadrature& quadrature, ThreadPool& threadPool):
+		ParametrizedSpline(basis, points, quadrature, &threadPool, std::pmr::get_default_resource())
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points,
+														 const Quadrature& quadrature, std::pmr::memory_resource* memoryResource):
+		ParametrizedSpline(basis, points, quadrature, nullptr, memoryResource)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::ParametrizedSpline::ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points,
+														 const Quadrature& quadrature, ThreadPool* threadPool, std::pmr::memory_resource* memoryResource)
+{
+	if(memoryResource == nullptr)
+	{
+		throw std::runtime_error("Memory resource cannot be null!");
+	}
+	
+	initialize(basis, points, quadrature, memoryResource);
+	solveSegments(basis, threadPool);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::solveSegments(const KnotBasis& basis, ThreadPool* threadPool)
+{
+	// second derivatives at first and last points are zero
+	const size_t pointCount = segments.size();
+	{
+		SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "solve", &Statistics::solvingTime);
+		
+		std::vector<simpline<T, Dim>::Vector> rightHandSides(pointCount, simpline<T, Dim>::Vector::Zero());
+		for(size_t i = 1; i < pointCount - 1; i++)
+		{
+			rightHandSides[i] = simplineInternal::computeSecondDerivativeRightHandSide<T, simpline<T, Dim>::Vector>(
+					segments[i - 1].col(0), segments[i].col(0), segments[i + 1].col(0), parameterValues[i] - parameterValues[i - 1],
+					parameterValues[i + 1] - parameterValues[i]);
+		}
+		simplineInternal::solveTridiagonalSystem(basis.lowerDiagonal, basis.upperFactors, basis.inversePivots, rightHandSides);
+		
+		for(size_t i = 0; i < pointCount; i++)
+		{
+			segments[i].col(2) = rightHandSides[i] / 2;
+		}
+	}
+	updateSegments(0, pointCount - 1, threadPool);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::initialize(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points,
+													  const Quadrature& quadrature, std::pmr::memory_resource* memoryResource)
+{
+	if(points.size() < 2)
+	{
+		throw std::runtime_error("Point list must contain at least two items!");
+	}
+	
+	if(basis.parameterValues.size() != points.size())
+	{
+		throw std::runtime_error("Number of parameter values must be equal to number of points!");
+	}
+	
+	if(quadrature.absoluteTolerance < 0 || quadrature.relativeTolerance < 0 ||
+	   (quadrature.absoluteTolerance == 0 && quadrature.relativeTolerance == 0 && quadrature.rule == Quadrature::ADAPTIVE_GAUSS_KRONROD_15))
+	{
+		throw std::runtime_error("Quadrature tolerances must be positive and at least one of them must be above 0!");
+	}
+	
+	parameterValues = simplineInternal::MappableVector<T>(points.size(), T(), memoryResource);
+	segments = simplineInternal::MappableVector<SegmentCoefficients>(points.size(), SegmentCoefficients::Zero(), memoryResource);
+	cumulativeLengths = simplineInternal::MappableVector<T>(points.size(), T(), memoryResource);
+	cumulativeLengthErrors = simplineInternal::MappableVector<T>(quadrature.rule == Quadrature::ADAPTIVE_GAUSS_KRONROD_15 ? points.size() : 0, T(),
+																 memoryResource);
+	this->quadrature = quadrature;
+	for(size_t i = 0; i < points.size(); i++)
+	{
+		parameterValues[i] = basis.parameterValues[i];
+		segments[i].col(0) = points[basis.sortedIndices[i]];
+	}
+#ifdef SIMPLINE_ENABLE_STATISTICS
+	statisticsRecorder.add(basis.statisticsRecorder.getStatistics());
+#endif
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::KnotBasis::KnotBasis(const std::vector<T>& parameterValues):
+		parameterValues(parameterValues.size())
+{
+	if(parameterValues.size() < 2)
+	{
+		throw std::runtime_error("Parameter value list must contain at least two items!");
+	}
+	
+	{
+		SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "sort", &Statistics::sortingTime);
+		
+		sortedIndices = simplineInternal::sortIndices(parameterValues);
+		for(size_t i = 0; i < sortedIndices.size(); i++)
+		{
+			this->parameterValues[i] = parameterValues[sortedIndices[i]];
+			if(i > 0 && this->parameterValues[i - 1] == this->parameterValues[i])
+			{
+				throw std::runtime_error("Multiple points cannot have the same parameter value.");
+			}
+		}
+	}
+	
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "factorize", &Statistics::factorizationTime);
+	
+	// natural spline system, whose first and last rows keep the second derivatives at zero
+	const size_t pointCount = this->parameterValues.size();
+	lowerDiagonal.assign(pointCount, 0.0);
+	std::vector<T> diagonal(pointCount, 2.0);
+	std::vector<T> upperDiagonal(pointCount, 0.0);
+	for(size_t i = 1; i < pointCount - 1; i++)
+	{
+		const T previousIntervalLength = this->parameterValues[i] - this->parameterValues[i - 1];
+		const T nextIntervalLength = this->parameterValues[i + 1] - this->parameterValues[i];
+		lowerDiagonal[i] = previousIntervalLength / (previousIntervalLength + nextIntervalLength);
+		upperDiagonal[i] = nextIntervalLength / (previousIntervalLength + nextIntervalLength);
+	}
+	diagonal[0] = 1;
+	diagonal[pointCount - 1] = 1;
+	simplineInternal::factorizeTridiagonalSystem(lowerDiagonal, diagonal, upperDiagonal, upperFactors, inversePivots);
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::KnotBasis::size() const
+{
+	return parameterValues.size();
+}
+
+template<typename T, int Dim>
+std::vector<typename simpline<T, Dim>::ParametrizedSpline>
+simpline<T, Dim>::KnotBasis::createSplines(const std::vector<std::vector<simpline<T, Dim>::Vector>>& pointSets) const
+{
+	return createSplines(pointSets, Quadrature(), nullptr);
+}
+
+template<typename T, int Dim>
+std::vector<typename simpline<T, Dim>::ParametrizedSpline>
+simpline<T, Dim>::KnotBasis::createSplines(const std::vector<std::vector<simpline<T, Dim>::Vector>>& pointSets, const Quadrature& quadrature) const
+{
+	return createSplines(pointSets, quadrature, nullptr);
+}
+
+template<typename T, int Dim>
+std::vector<typename simpline<T, Dim>::ParametrizedSpline>
+simpline<T, Dim>::KnotBasis::createSplines(const std::vector<std::vector<simpline<T, Dim>::Vector>>& pointSets, const Quadrature& quadrature,
+										   ThreadPool& threadPool) const
+{
+	return createSplines(pointSets, quadrature, &threadPool);
+}
+
+template<typename T, int Dim>
+std::vector<typename simpline<T, Dim>::ParametrizedSpline>
+simpline<T, Dim>::KnotBasis::createSplines(const std::vector<std::vector<simpline<T, Dim>::Vector>>& pointSets, const Quadrature& quadrature,
+										   ThreadPool* threadPool) const
+{
+	std::vector<ParametrizedSpline> splines(pointSets.size());
+	for(size_t i = 0; i < pointSets.size(); i++)
+	{
+		splines[i].initialize(*this, pointSets[i], quadrature, std::pmr::get_default_resource());
+	}
+	
+	// the factorization is shared, each spline only solves its own right-hand side
+	const auto solveSplines = [this, &splines](const size_t& first, const size_t& last)
+	{
+		for(size_t i = first; i < last; i++)
+		{
+			splines[i].solveSegments(*this, nullptr);
+		}
+	};
+	if(threadPool)
+	{
+		threadPool->parallelFor(splines.size(), 1, solveSplines);
+	}
+	else
+	{
+		solveSplines(0, splines.size());
+	}
+	
+	return splines;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::appendPoints(const std::vector<T>& newParameterValues, const std::vector<simpline<T, Dim>::Vector>& newPoints)
+{
+	appendPoints(newParameterValues, newPoints, simplineInternal::defaultDecayTolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::appendPoints(const std::vector<T>& newParameterValues, const std::vector<simpline<T, Dim>::Vector>& newPoints,
+												   const T& decayTolerance)
+{
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot append points to empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	if(newParameterValues.size() != newPoints.size())
+	{
+		throw std::runtime_error("Number of parameter values must be equal to number of points!");
+	}
+	
+	// the points are validated before the spline is changed, so that it is left as it was when they are rejected
+	const size_t windowSize = simplineInternal::computeWindowSize(decayTolerance);
+	for(size_t i = 0; i < newParameterValues.size(); i++)
+	{
+		if(!std::isfinite(newParameterValues[i]))
+		{
+			throw std::runtime_error("Parameter values must be finite!");
+		}
+	}
+	
+	const std::vector<size_t> sortedIndices = simplineInternal::sortIndices(newParameterValues);
+	for(size_t i = 0; i < sortedIndices.size(); i++)
+	{
+		if(i == 0 && newParameterValues[sortedIndices[i]] <= parameterValues[parameterValues.size() - 1])
+		{
+			throw std::runtime_error("Appended points must have parameter values greater than the ones of the spline.");
+		}
+		
+		if(i > 0 && newParameterValues[sortedIndices[i]] == newParameterValues[sortedIndices[i - 1]])
+		{
+			throw std::runtime_error("Multiple points cannot have the same parameter value.");
+		}
+	}
+	
+	const size_t previousLastPointIndex = parameterValues.size() - 1;
+	for(size_t i = 0; i < sortedIndices.size(); i++)
+	{
+		parameterValues.push_back(newParameterValues[sortedIndices[i]]);
+		segments.push_back(SegmentCoefficients::Zero());
+		segments.back().col(0) = newPoints[sortedIndices[i]];
+	}
+	
+	cumulativeLengths.resize(segments.size());
+	if(!cumulativeLengthErrors.empty())
+	{
+		cumulativeLengthErrors.resize(segments.size());
+	}
+	
+	// the previous last point is not an end anymore, the second derivative of the new last point is zero
+	solveWindow(previousLastPointIndex, segments.size() - 1, windowSize);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::movePoint(const size_t& pointIndex, const simpline<T, Dim>::Vector& newPoint)
+{
+	replaceRange(pointIndex, std::vector<simpline<T, Dim>::Vector>(1, newPoint), simplineInternal::defaultDecayTolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::movePoint(const size_t& pointIndex, const simpline<T, Dim>::Vector& newPoint, const T& decayTolerance)
+{
+	replaceRange(pointIndex, std::vector<simpline<T, Dim>::Vector>(1, newPoint), decayTolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::replaceRange(const size_t& firstPointIndex, const std::vector<simpline<T, Dim>::Vector>& newPoints)
+{
+	replaceRange(firstPointIndex, newPoints, simplineInternal::defaultDecayTolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::replaceRange(const size_t& firstPointIndex, const std::vector<simpline<T, Dim>::Vector>& newPoints,
+												   const T& decayTolerance)
+{
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot replace points of empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	// the sum of the index and the number of points could overflow
+	if(newPoints.size() == 0 || firstPointIndex > segments.size() || newPoints.size() > segments.size() - firstPointIndex)
+	{
+		throw std::runtime_error("Replacement of points " + std::to_string(firstPointIndex) + " to " + std::to_string(firstPointIndex + newPoints.size()) +
+								 " requested. Point indices must be between 0 and " + std::to_string(segments.size() - 1) + ".");
+	}
+	
+	// validated before the points are replaced, so that the spline is left as it was when they are rejected
+	const size_t windowSize = simplineInternal::computeWindowSize(decayTolerance);
+	for(const simpline<T, Dim>::Vector& newPoint: newPoints)
+	{
+		if(!newPoint.allFinite())
+		{
+			throw std::runtime_error("Points must be finite!");
+		}
+	}
+	
+	for(size_t i = 0; i < newPoints.size(); i++)
+	{
+		segments[firstPointIndex + i].col(0) = newPoints[i];
+	}
+	
+	// the equations of the neighbours of the replaced points change as well
+	const size_t lastPointIndex = firstPointIndex + newPoints.size() - 1;
+	solveWindow(firstPointIndex > 0 ? firstPointIndex - 1 : 0, std::min(lastPointIndex + 1, segments.size() - 1), windowSize);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::solveWindow(const size_t& firstChangedPointIndex, const size_t& lastChangedPointIndex, const size_t& windowSize)
+{
+	// changes of the equations of some points propagate to the second derivatives of the other points but decay geometrically, so only a window
+	// around the changed points is solved again, segments outside of it are left untouched
+	const size_t firstPointIndex = firstChangedPointIndex > windowSize ? firstChangedPointIndex - windowSize : 0;
+	const size_t lastPointIndex = std::min(lastChangedPointIndex + windowSize, segments.size() - 1);
+	solveSecondDerivatives(firstPointIndex, lastPointIndex);
+	updateSegments(firstPointIndex, lastPointIndex, nullptr);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::solveSecondDerivatives(const size_t& firstPointIndex, const size_t& lastPointIndex)
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "solve", &Statistics::solvingTime);
+	
+	// natural spline system, only the three diagonals are stored since every row couples a point with its two neighbours
+	// second derivatives at the first and last points of the window are kept as they are
+	const size_t pointCount = lastPointIndex - firstPointIndex + 1;
+	std::vector<T> lowerDiagonal(pointCount, 0.0);
+	std::vector<T> diagonal(pointCount, 2.0);
+	std::vector<T> upperDiagonal(pointCount, 0.0);
+	std::vector<simpline<T, Dim>::Vector> rightHandSides(pointCount);
+	for(size_t i = 1; i < pointCount - 1; i++)
+	{
+		const size_t j = firstPointIndex + i;
+		const T previousIntervalLength = parameterValues[j] - parameterValues[j - 1];
+		const T nextIntervalLength = parameterValues[j + 1] - parameterValues[j];
+		lowerDiagonal[i] = previousIntervalLength / (previousIntervalLength + nextIntervalLength);
+		upperDiagonal[i] = nextIntervalLength / (previousIntervalLength + nextIntervalLength);
+		rightHandSides[i] = simplineInternal::computeSecondDerivativeRightHandSide<T, simpline<T, Dim>::Vector>(
+				segments[j - 1].col(0), segments[j].col(0), segments[j + 1].col(0), previousIntervalLength, nextIntervalLength);
+	}
+	diagonal[0] = 1;
+	rightHandSides[0] = 2 * segments[firstPointIndex].col(2);
+	diagonal[pointCount - 1] = 1;
+	rightHandSides[pointCount - 1] = 2 * segments[lastPointIndex].col(2);
+	
+	// the factorization only depends on the parameter values, the three axes are then solved together
+	std::vector<T> upperFactors;
+	std::vector<T> inversePivots;
+	simplineInternal::factorizeTridiagonalSystem(lowerDiagonal, diagonal, upperDiagonal, upperFactors, inversePivots);
+	simplineInternal::solveTridiagonalSystem(lowerDiagonal, upperFactors, inversePivots, rightHandSides);
+	
+	for(size_t i = 0; i < pointCount; i++)
+	{
+		segments[firstPointIndex + i].col(2) = rightHandSides[i] / 2;
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::updateSegments(const size_t& firstPointIndex, const size_t& lastPointIndex, ThreadPool* threadPool)
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "integrateLength", &Statistics::lengthIntegrationTime);
+	
+	boundingVolumeHierarchy.reset();
+	
+	// segments are independent from each other, their lengths are first stored in place of the cumulative lengths, which are then summed serially so
+	// that they do not depend on the threads
+	const T previousLength = cumulativeLengths[lastPointIndex];
+	const T previousLengthError = cumulativeLengthErrors.empty() ? 0 : cumulativeLengthErrors[lastPointIndex];
+	const auto updateRange = [this, &firstPointIndex](const size_t& first, const size_t& last)
+	{
+		// work done by the other threads of the pool is counted separately
+		SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, nullptr, nullptr);
+		
+		for(size_t j = firstPointIndex + first; j < firstPointIndex + last; j++)
+		{
+			const T intervalLength = parameterValues[j + 1] - parameterValues[j];
+			const simpline<T, Dim>::Vector secondDerivative = 2 * segments[j].col(2);
+			const simpline<T, Dim>::Vector nextSecondDerivative = 2 * segments[j + 1].col(2);
+			segments[j].col(1) = (segments[j + 1].col(0) - segments[j].col(0)) / intervalLength - (intervalLength * secondDerivative / 3.0) -
+								 (intervalLength * nextSecondDerivative / 6.0);
+			segments[j].col(3) = (nextSecondDerivative - secondDerivative) / (6.0 * intervalLength);
+			T errorEstimate;
+			cumulativeLengths[j + 1] = integrateLength(j, parameterValues[j], parameterValues[j + 1], errorEstimate);
+			if(!cumulativeLengthErrors.empty())
+			{
+				cumulativeLengthErrors[j + 1] = errorEstimate;
+			}
+		}
+	};
+	if(threadPool)
+	{
+		threadPool->parallelFor(lastPointIndex - firstPointIndex, simplineInternal::parallelChunkSize, updateRange);
+	}
+	else
+	{
+		updateRange(0, lastPointIndex - firstPointIndex);
+	}
+	
+	// cumulative lengths and errors after the updated segments are shifted by the change of the updated segments
+	for(size_t j = firstPointIndex; j < lastPointIndex; j++)
+	{
+		cumulativeLengths[j + 1] += cumulativeLengths[j];
+	}
+	const T lengthShift = cumulativeLengths[lastPointIndex] - previousLength;
+	for(size_t j = lastPointIndex + 1; j < cumulativeLengths.size(); j++)
+	{
+		cumulativeLengths[j] += lengthShift;
+	}
+	
+	if(!cumulativeLengthErrors.empty())
+	{
+		for(size_t j = firstPointIndex; j < lastPointIndex; j++)
+		{
+			cumulativeLengthErrors[j + 1] += cumulativeLengthErrors[j];
+		}
+		const T lengthErrorShift = cumulativeLengthErrors[lastPointIndex] - previousLengthError;
+		for(size_t j = lastPointIndex + 1; j < cumulativeLengthErrors.size(); j++)
+		{
+			cumulativeLengthErrors[j] += lengthErrorShift;
+		}
+	}
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::ParametrizedSpline::findSegmentIndex(const T& parameterValue) const
+{
+	return simplineInternal::findIntervalIndex(parameterValues, parameterValue, std::numeric_limits<size_t>::max());
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::ParametrizedSpline::findSegmentIndex(const T& parameterValue, const SplineCursor& cursor) const
+{
+	return simplineInternal::findIntervalIndex(parameterValues, parameterValue, cursor.segmentIndex);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ParametrizedSpline::computeValue(const size_t& segmentIndex, const T& parameterValue) const
+{
+	return simplineInternal::computeSegmentValue(segments[segmentIndex], T(parameterValue - parameterValues[segmentIndex]));
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ParametrizedSpline::computeGradient(const size_t& segmentIndex, const T& parameterValue) const
+{
+	return simplineInternal::computeSegmentGradient(segments[segmentIndex], T(parameterValue - parameterValues[segmentIndex]));
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ParametrizedSpline::computeSecondDerivative(const size_t& segmentIndex, const T& parameterValue) const
+{
+	return simplineInternal::computeSegmentSecondDerivative(segments[segmentIndex], T(parameterValue - parameterValues[segmentIndex]));
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ParametrizedSpline::computeLength(const size_t& segmentIndex, const T& startParameterValue, const T& endParameterValue,
+													 T& errorEstimate) const
+{
+	if(startParameterValue == parameterValues[segmentIndex] && endParameterValue == parameterValues[segmentIndex + 1])
+	{
+		errorEstimate = cumulativeLengthErrors.empty() ? std::numeric_limits<T>::quiet_NaN() :
+						cumulativeLengthErrors[segmentIndex + 1] - cumulativeLengthErrors[segmentIndex];
+		return cumulativeLengths[segmentIndex + 1] - cumulativeLengths[segmentIndex];
+	}
+	
+	return integrateLength(segmentIndex, startParameterValue, endParameterValue, errorEstimate);
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ParametrizedSpline::integrateLength(const size_t& segmentIndex, const T& startParameterValue, const T& endParameterValue,
+													   T& errorEstimate) const
+{
+	return simplineInternal::integrateSegmentLength(segments[segmentIndex], parameterValues[segmentIndex], quadrature, startParameterValue, endParameterValue,
+													errorEstimate);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ParametrizedSpline::getValue(const T& parameterValue) const
+{
+	SplineCursor cursor;
+	return getValue(parameterValue, cursor);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ParametrizedSpline::getValue(const T& parameterValue, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "getValue", nullptr);
+	
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get value from empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	if(parameterValue < parameterValues[0] || parameterValue > parameterValues[parameterValues.size() - 1])
+	{
+		throw std::runtime_error("Value requested at parameterValue=" + std::to_string(parameterValue) + ". Parameter Value must be between " +
+								 std::to_string(parameterValues[0]) + " and " + std::to_string(parameterValues[parameterValues.size() - 1]) + ".");
+	}
+	
+	cursor.segmentIndex = findSegmentIndex(parameterValue, cursor);
+	
+	return computeValue(cursor.segmentIndex, parameterValue);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ParametrizedSpline::getGradient(const T& parameterValue) const
+{
+	SplineCursor cursor;
+	return getGradient(parameterValue, cursor);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Vector simpline<T, Dim>::ParametrizedSpline::getGradient(const T& parameterValue, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "getGradient", nullptr);
+	
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get gradient from empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	if(parameterValue < parameterValues[0] || parameterValue > parameterValues[parameterValues.size() - 1])
+	{
+		throw std::runtime_error("Gradient requested at parameterValue=" + std::to_string(parameterValue) + ". Parameter Value must be between " +
+								 std::to_string(parameterValues[0]) + " and " + std::to_string(parameterValues[parameterValues.size() - 1]) + ".");
+	}
+	
+	cursor.segmentIndex = findSegmentIndex(parameterValue, cursor);
+	
+	return computeGradient(cursor.segmentIndex, parameterValue);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::evaluate(const T* queriedParameterValues, const size_t& count, T* values, T* gradients) const
+{
+	SplineCursor cursor;
+	evaluate(queriedParameterValues, count, values, gradients, cursor);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::evaluate(const T* queriedParameterValues, const size_t& count, T* values, T* gradients, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "evaluate", nullptr);
+	
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot evaluate empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	const size_t lastSegmentIndex = parameterValues.size() - 2;
+	T localParameterValues[simplineInternal::evaluationBlockSize];
+	size_t blockStartIndex = 0;
+	while(blockStartIndex < count)
+	{
+		const T& firstParameterValue = queriedParameterValues[blockStartIndex];
+		if(firstParameterValue < parameterValues[0] || firstParameterValue > parameterValues[parameterValues.size() - 1])
+		{
+			throw std::runtime_error("Evaluation requested at parameterValue=" + std::to_string(firstParameterValue) + ". Parameter Value must be between " +
+									 std::to_string(parameterValues[0]) + " and " + std::to_string(parameterValues[parameterValues.size() - 1]) + ".");
+		}
+		
+		const size_t segmentIndex = findSegmentIndex(firstParameterValue, cursor);
+		cursor.segmentIndex = segmentIndex;
+		
+		// following parameter values falling in the same segment are evaluated in the same block
+		const T& segmentStart = parameterValues[segmentIndex];
+		const T& segmentEnd = parameterValues[segmentIndex + 1];
+		size_t blockSize = 0;
+		while(blockStartIndex + blockSize < count && blockSize < simplineInternal::evaluationBlockSize)
+		{
+			const T& parameterValue = queriedParameterValues[blockStartIndex + blockSize];
+			if(parameterValue < segmentStart || parameterValue > segmentEnd || (parameterValue == segmentEnd && segmentIndex < lastSegmentIndex))
+			{
+				break;
+			}
+			localParameterValues[blockSize] = parameterValue - segmentStart;
+			blockSize++;
+		}
+		
+		simplineInternal::evaluateSegmentBlock(localParameterValues, blockSize, segments[segmentIndex], values ? values + Dim * blockStartIndex : nullptr,
+											   gradients ? gradients + Dim * blockStartIndex : nullptr);
+		blockStartIndex += blockSize;
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::evaluate(const T* queriedParameterValues, const size_t& count, T* values, T* gradients,
+													ThreadPool& threadPool) const
+{
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot evaluate empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	threadPool.parallelFor(count, simplineInternal::parallelChunkSize, [&](const size_t& first, const size_t& last)
+	{
+		SplineCursor cursor;
+		evaluate(queriedParameterValues + first, last - first, values ? values + Dim * first : nullptr, gradients ? gradients + Dim * first : nullptr,
+				 cursor);
+	});
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::State simpline<T, Dim>::ParametrizedSpline::evaluateState(const T& parameterValue, const bool& withFrenetFrame) const
+{
+	SplineCursor cursor;
+	return evaluateState(parameterValue, cursor, withFrenetFrame);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::State simpline<T, Dim>::ParametrizedSpline::evaluateState(const T& parameterValue, SplineCursor& cursor, const bool& withFrenetFrame) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "evaluateState", nullptr);
+	
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot evaluate state of empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	if(parameterValue < parameterValues[0] || parameterValue > parameterValues[parameterValues.size() - 1])
+	{
+		throw std::runtime_error("State requested at parameterValue=" + std::to_string(parameterValue) + ". Parameter Value must be between " +
+								 std::to_string(parameterValues[0]) + " and " + std::to_string(parameterValues[parameterValues.size() - 1]) + ".");
+	}
+	
+	cursor.segmentIndex = findSegmentIndex(parameterValue, cursor);
+	
+	return computeState(cursor.segmentIndex, parameterValue, withFrenetFrame);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::ParametrizedSpline::tryGetValue(const T& parameterValue, simpline<T, Dim>::Vector& value,
+																					 SplineCursor& cursor) const noexcept
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "tryGetValue", nullptr);
+	
+	T clampedParameterValue;
+	const Status status = clampParameterValue(parameterValue, clampedParameterValue);
+	if(status != SUCCESS && status != CLAMPED)
+	{
+		return status;
+	}
+	
+	cursor.segmentIndex = findSegmentIndex(clampedParameterValue, cursor);
+	value = computeValue(cursor.segmentIndex, clampedParameterValue);
+	return status;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::ParametrizedSpline::tryGetGradient(const T& parameterValue, simpline<T, Dim>::Vector& gradient,
+																						SplineCursor& cursor) const noexcept
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "tryGetGradient", nullptr);
+	
+	T clampedParameterValue;
+	const Status status = clampParameterValue(parameterValue, clampedParameterValue);
+	if(status != SUCCESS && status != CLAMPED)
+	{
+		return status;
+	}
+	
+	cursor.segmentIndex = findSegmentIndex(clampedParameterValue, cursor);
+	gradient = computeGradient(cursor.segmentIndex, clampedParameterValue);
+	return status;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::ParametrizedSpline::tryEvaluateState(const T& parameterValue, State& state, SplineCursor& cursor,
+																						  const bool& withFrenetFrame) const noexcept
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "tryEvaluateState", nullptr);
+	
+	T clampedParameterValue;
+	const Status status = clampParameterValue(parameterValue, clampedParameterValue);
+	if(status != SUCCESS && status != CLAMPED)
+	{
+		return status;
+	}
+	
+	cursor.segmentIndex = findSegmentIndex(clampedParameterValue, cursor);
+	state = computeState(cursor.segmentIndex, clampedParameterValue, withFrenetFrame);
+	return status;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::State simpline<T, Dim>::ParametrizedSpline::computeState(const size_t& segmentIndex, const T& parameterValue,
+																					 const bool& withFrenetFrame) const
+{
+	State state = { computeValue(segmentIndex, parameterValue), computeGradient(segmentIndex, parameterValue),
+					computeSecondDerivative(segmentIndex, parameterValue), 0, simpline<T, Dim>::Vector::Zero(), simpline<T, Dim>::Vector::Zero(),
+					simpline<T, Dim>::Vector::Zero() };
+	if(withFrenetFrame)
+	{
+		simplineInternal::computeFrenetFrame<T>(state);
+	}
+	
+	return state;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::ParametrizedSpline::clampParameterValue(const T& parameterValue, T& clampedParameterValue) const noexcept
+{
+	if(parameterValues.size() == 0)
+	{
+		return EMPTY_SPLINE;
+	}
+	
+	if(std::isnan(parameterValue))
+	{
+		return INVALID_ARGUMENT;
+	}
+	
+	if(parameterValue < parameterValues[0])
+	{
+		clampedParameterValue = parameterValues[0];
+		return CLAMPED;
+	}
+	
+	if(parameterValue > parameterValues[parameterValues.size() - 1])
+	{
+		clampedParameterValue = parameterValues[parameterValues.size() - 1];
+		return CLAMPED;
+	}
+	
+	clampedParameterValue = parameterValue;
+	return SUCCESS;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ParametrizedSpline::getLength() const
+{
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get length of empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	return cumulativeLengths[cumulativeLengths.size() - 1];
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ParametrizedSpline::getLengthErrorEstimate() const
+{
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get length of empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	return cumulativeLengthErrors.empty() ? std::numeric_limits<T>::quiet_NaN() : cumulativeLengthErrors[cumulativeLengthErrors.size() - 1];
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ParametrizedSpline::getLength(const T& startParameterValue, const T& endParameterValue) const
+{
+	T errorEstimate;
+	return getLength(startParameterValue, endParameterValue, errorEstimate);
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ParametrizedSpline::getLength(const T& startParameterValue, const T& endParameterValue, T& errorEstimate) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "getLength", nullptr);
+	
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get length of empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	if(startParameterValue > endParameterValue)
+	{
+		throw std::runtime_error("Length requested from parameterValue=" + std::to_string(startParameterValue) + " to parameterValue=" +
+								 std::to_string(endParameterValue) + ". End parameter value must be greater or equal to start parameter value.");
+	}
+	
+	if(startParameterValue < parameterValues[0] || endParameterValue > parameterValues[parameterValues.size() - 1])
+	{
+		throw std::runtime_error("Length requested from parameterValue=" + std::to_string(startParameterValue) + " to parameterValue=" +
+								 std::to_string(endParameterValue) + ". Parameter value must be between " + std::to_string(parameterValues[0]) + " and " +
+								 std::to_string(parameterValues[parameterValues.size() - 1]) + ".");
+	}
+	
+	const size_t startSegmentIndex = findSegmentIndex(startParameterValue);
+	const size_t endSegmentIndex = findSegmentIndex(endParameterValue);
+	
+	// special case: length computation for when startParameterValue and endParameterValue are in the same spline segment
+	if(startSegmentIndex == endSegmentIndex)
+	{
+		return computeLength(startSegmentIndex, startParameterValue, endParameterValue, errorEstimate);
+	}
+	
+	// only the partial first and last segments need to be integrated, full segments in between come from the cumulative lengths
+	T startErrorEstimate;
+	T endErrorEstimate;
+	const T length = computeLength(startSegmentIndex, startParameterValue, parameterValues[startSegmentIndex + 1], startErrorEstimate) +
+					 (cumulativeLengths[endSegmentIndex] - cumulativeLengths[startSegmentIndex + 1]) +
+					 computeLength(endSegmentIndex, parameterValues[endSegmentIndex], endParameterValue, endErrorEstimate);
+	errorEstimate = cumulativeLengthErrors.empty() ? std::numeric_limits<T>::quiet_NaN() :
+					startErrorEstimate + (cumulativeLengthErrors[endSegmentIndex] - cumulativeLengthErrors[startSegmentIndex + 1]) + endErrorEstimate;
+	return length;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ParametrizedSpline::getParameterValue(const T& length, const T& tolerance) const
+{
+	SplineCursor cursor;
+	return getParameterValue(length, tolerance, cursor);
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::ParametrizedSpline::getParameterValue(const T& length, const T& tolerance, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "getParameterValue", nullptr);
+	
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot get parameter value from empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	if(length < 0.0 || length > cumulativeLengths[cumulativeLengths.size() - 1])
+	{
+		throw std::runtime_error("Parameter value requested at length=" + std::to_string(length) + ". Length must be between 0.0 and " +
+								 std::to_string(cumulativeLengths[cumulativeLengths.size() - 1]) + ".");
+	}
+	
+	if(tolerance <= 0)
+	{
+		throw std::runtime_error("Tolerance must be above 0!");
+	}
+	
+	const size_t segmentIndex = simplineInternal::findIntervalIndex(cumulativeLengths, length, cursor.segmentIndex);
+	cursor.segmentIndex = segmentIndex;
+	
+	return simplineInternal::invertSegmentLength(segments.data(), parameterValues.data(), cumulativeLengths.data(), segmentIndex, quadrature, length,
+												 tolerance, cursor.anchorSegmentIndex, cursor.anchorParameterValue, cursor.anchorLength);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::ParametrizedSpline::BoundingBox simpline<T, Dim>::ParametrizedSpline::computeSegmentBoundingBox(const size_t& segmentIndex) const
+{
+	// a cubic segment lies in the convex hull of its Bernstein control points
+	const SegmentCoefficients& coefficients = segments[segmentIndex];
+	const T intervalLength = parameterValues[segmentIndex + 1] - parameterValues[segmentIndex];
+	const simpline<T, Dim>::Vector firstControlPoint = coefficients.col(0) + coefficients.col(1) * (intervalLength / 3);
+	const simpline<T, Dim>::Vector secondControlPoint = firstControlPoint +
+														(coefficients.col(1) + coefficients.col(2) * intervalLength) * (intervalLength / 3);
+	const simpline<T, Dim>::Vector lastPoint = segments[segmentIndex + 1].col(0);
+	
+	BoundingBox box;
+	box.minimum = coefficients.col(0).cwiseMin(firstControlPoint).cwiseMin(secondControlPoint).cwiseMin(lastPoint);
+	box.maximum = coefficients.col(0).cwiseMax(firstControlPoint).cwiseMax(secondControlPoint).cwiseMax(lastPoint);
+	return box;
+}
+
+template<typename T, int Dim>
+std::shared_ptr<const typename simpline<T, Dim>::ParametrizedSpline::BoundingVolumeHierarchy>
+simpline<T, Dim>::ParametrizedSpline::getBoundingVolumeHierarchy() const
+{
+	// concurrent projections may build the hierarchy more than once, but all of them use a complete one
+	std::shared_ptr<const BoundingVolumeHierarchy> hierarchy = std::atomic_load(&boundingVolumeHierarchy);
+	if(hierarchy)
+	{
+		return hierarchy;
+	}
+	
+	const size_t segmentCount = segments.size() - 1;
+	std::shared_ptr<BoundingVolumeHierarchy> newHierarchy = std::make_shared<BoundingVolumeHierarchy>(1);
+	std::vector<BoundingBox>& leaves = newHierarchy->front();
+	leaves.resize((segmentCount + simplineInternal::boundingVolumeLeafSize - 1) / simplineInternal::boundingVolumeLeafSize);
+	for(size_t i = 0; i < leaves.size(); i++)
+	{
+		const size_t firstSegmentIndex = i * simplineInternal::boundingVolumeLeafSize;
+		const size_t lastSegmentIndex = std::min(firstSegmentIndex + simplineInternal::boundingVolumeLeafSize, segmentCount);
+		leaves[i] = computeSegmentBoundingBox(firstSegmentIndex);
+		for(size_t j = firstSegmentIndex + 1; j < lastSegmentIndex; j++)
+		{
+			const BoundingBox box = computeSegmentBoundingBox(j);
+			leaves[i].minimum = leaves[i].minimum.cwiseMin(box.minimum);
+			leaves[i].maximum = leaves[i].maximum.cwiseMax(box.maximum);
+		}
+	}
+	
+	while(newHierarchy->back().size() > 1)
+	{
+		const std::vector<BoundingBox>& children = newHierarchy->back();
+		std::vector<BoundingBox> parents((children.size() + 1) / 2);
+		for(size_t i = 0; i < parents.size(); i++)
+		{
+			parents[i] = children[2 * i];
+			if(2 * i + 1 < children.size())
+			{
+				parents[i].minimum = parents[i].minimum.cwiseMin(children[2 * i + 1].minimum);
+				parents[i].maximum = parents[i].maximum.cwiseMax(children[2 * i + 1].maximum);
+			}
+		}
+		newHierarchy->push_back(std::move(parents));
+	}
+	
+	hierarchy = newHierarchy;
+	std::atomic_store(&boundingVolumeHierarchy, hierarchy);
+	return hierarchy;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::projectOnSegment(const size_t& segmentIndex, const simpline<T, Dim>::Vector& point, T& parameterValue,
+															T& squaredDistance) const
+{
+	const SegmentCoefficients& coefficients = segments[segmentIndex];
+	const T intervalLength = parameterValues[segmentIndex + 1] - parameterValues[segmentIndex];
+	const auto computeOffset = [&coefficients, &point](const T& localParameterValue)
+	{
+		return simpline<T, Dim>::Vector(simplineInternal::computeSegmentValue(coefficients, localParameterValue) - point);
+	};
+	
+	// the derivative of half the squared distance is the product of the offset and the gradient, a polynomial of degree 5 whose roots hold all the
+	// local minima, the global one may lie in a different part of the segment than the closest of a few samples
+	T slopeCoefficients[6] = {};
+	for(size_t i = 0; i < 4; i++)
+	{
+		const simpline<T, Dim>::Vector offsetCoefficient = i == 0 ? simpline<T, Dim>::Vector(coefficients.col(0) - point) :
+															   simpline<T, Dim>::Vector(coefficients.col(i));
+		for(size_t j = 1; j < 4; j++)
+		{
+			slopeCoefficients[i + j - 1] += j * offsetCoefficient.dot(coefficients.col(j));
+		}
+	}
+	T roots[5];
+	const size_t rootCount = simplineInternal::findQuinticRoots(slopeCoefficients, intervalLength, roots);
+	
+	T closestLocalParameterValue = 0;
+	T closestSquaredDistance = computeOffset(0).squaredNorm();
+	for(size_t i = 0; i <= rootCount; i++)
+	{
+		const T candidate = i < rootCount ? roots[i] : intervalLength;
+		const T candidateSquaredDistance = computeOffset(candidate).squaredNorm();
+		if(candidateSquaredDistance < closestSquaredDistance)
+		{
+			closestLocalParameterValue = candidate;
+			closestSquaredDistance = candidateSquaredDistance;
+		}
+	}
+	
+	parameterValue = std::min(parameterValues[segmentIndex] + closestLocalParameterValue, parameterValues[segmentIndex + 1]);
+	squaredDistance = closestSquaredDistance;
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::ParametrizedSpline::projectOnSpline(const simpline<T, Dim>::Vector& point, const size_t& hintSegmentIndex, T& parameterValue,
+															 T& squaredDistance) const
+{
+	const std::shared_ptr<const BoundingVolumeHierarchy> hierarchy = getBoundingVolumeHierarchy();
+	const size_t segmentCount = segments.size() - 1;
+	const auto computeSquaredBoxDistance = [&point](const BoundingBox& box)
+	{
+		return (box.minimum - point).cwiseMax(point - box.maximum).cwiseMax(T(0)).squaredNorm();
+	};
+	
+	// the hint gives an upper bound on the distance before descending the hierarchy
+	size_t segmentIndex = 0;
+	squaredDistance = std::numeric_limits<T>::infinity();
+	if(hintSegmentIndex < segmentCount)
+	{
+		segmentIndex = hintSegmentIndex;
+		projectOnSegment(segmentIndex, point, parameterValue, squaredDistance);
+	}
+	
+	// depth-first descent visiting the closest child first, which holds at most one pending sibling per level
+	struct Node
+	{
+		size_t level;
+		size_t index;
+		T squaredDistance;
+	};
+	std::vector<Node> pendingNodes;
+	pendingNodes.reserve(2 * hierarchy->size());
+	pendingNodes.push_back({hierarchy->size() - 1, 0, computeSquaredBoxDistance(hierarchy->back().front())});
+	while(!pendingNodes.empty())
+	{
+		const Node node = pendingNodes.back();
+		pendingNodes.pop_back();
+		if(node.squaredDistance >= squaredDistance)
+		{
+			continue;
+		}
+		
+		if(node.level == 0)
+		{
+			const size_t firstSegmentIndex = node.index * simplineInternal::boundingVolumeLeafSize;
+			const size_t lastSegmentIndex = std::min(firstSegmentIndex + simplineInternal::boundingVolumeLeafSize, segmentCount);
+			for(size_t j = firstSegmentIndex; j < lastSegmentIndex; j++)
+			{
+				if(j == hintSegmentIndex || computeSquaredBoxDistance(computeSegmentBoundingBox(j)) >= squaredDistance)
+				{
+					continue;
+				}
+				
+				T segmentParameterValue;
+				T segmentSquaredDistance;
+				projectOnSegment(j, point, segmentParameterValue, segmentSquaredDistance);
+				if(segmentSquaredDistance < squaredDistance)
+				{
+					segmentIndex = j;
+					parameterValue = segmentParameterValue;
+					squaredDistance = segmentSquaredDistance;
+				}
+			}
+			continue;
+		}
+		
+		const std::vector<BoundingBox>& children = (*hierarchy)[node.level - 1];
+		const size_t firstChildIndex = 2 * node.index;
+		if(firstChildIndex + 1 >= children.size())
+		{
+			pendingNodes.push_back({node.level - 1, firstChildIndex, node.squaredDistance});
+			continue;
+		}
+		
+		const Node firstChild = {node.level - 1, firstChildIndex, computeSquaredBoxDistance(children[firstChildIndex])};
+		const Node secondChild = {node.level - 1, firstChildIndex + 1, computeSquaredBoxDistance(children[firstChildIndex + 1])};
+		if(firstChild.squaredDistance <= secondChild.squaredDistance)
+		{
+			pendingNodes.push_back(secondChild);
+			pendingNodes.push_back(firstChild);
+		}
+		else
+		{
+			pendingNodes.push_back(firstChild);
+			pendingNodes.push_back(secondChild);
+		}
+	}
+	
+	return segmentIndex;
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::ParametrizedSpline::projectOnSegments(const simpline<T, Dim>::Vector& point, const size_t& firstSegmentIndex,
+															   const size_t& lastSegmentIndex, T& parameterValue, T& squaredDistance) const
+{
+	size_t segmentIndex = firstSegmentIndex;
+	projectOnSegment(segmentIndex, point, parameterValue, squaredDistance);
+	for(size_t i = firstSegmentIndex + 1; i <= lastSegmentIndex; i++)
+	{
+		T segmentParameterValue;
+		T segmentSquaredDistance;
+		projectOnSegment(i, point, segmentParameterValue, segmentSquaredDistance);
+		if(segmentSquaredDistance < squaredDistance)
+		{
+			segmentIndex = i;
+			parameterValue = segmentParameterValue;
+			squaredDistance = segmentSquaredDistance;
+		}
+	}
+	return segmentIndex;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Projection simpline<T, Dim>::ParametrizedSpline::project(const simpline<T, Dim>::Vector& point) const
+{
+	SplineCursor cursor;
+	return project(point, cursor);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Projection simpline<T, Dim>::ParametrizedSpline::project(const simpline<T, Dim>::Vector& point, SplineCursor& cursor) const
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "project", nullptr);
+	
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot project on empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	Projection projection;
+	T squaredDistance;
+	cursor.segmentIndex = projectOnSpline(point, cursor.segmentIndex, projection.parameterValue, squaredDistance);
+	projection.time = projection.parameterValue;
+	projection.point = computeValue(cursor.segmentIndex, projection.parameterValue);
+	projection.distance = std::sqrt(squaredDistance);
+	return projection;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::save(const std::string& fileName) const
+{
+	write(fileName, simplineInternal::PARAMETRIZED_SPLINE_FILE, 0, 0, 0);
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::ParametrizedSpline simpline<T, Dim>::ParametrizedSpline::load(const std::string& fileName)
+{
+	T speed, duration, tolerance;
+	return read(fileName, simplineInternal::PARAMETRIZED_SPLINE_FILE, speed, duration, tolerance);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::validate() const
+{
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot validate empty parametrized spline. Use non-default constructor to provide points.");
+	}
+	
+	for(size_t i = 0; i < parameterValues.size(); i++)
+	{
+		if(!std::isfinite(parameterValues[i]) || (i > 0 && !(parameterValues[i] > parameterValues[i - 1])))
+		{
+			throw std::runtime_error("Spline is corrupted, its parameter values must be finite and strictly increasing.");
+		}
+		
+		if(!segments[i].allFinite())
+		{
+			throw std::runtime_error("Spline is corrupted, its segment coefficients must be finite.");
+		}
+		
+		if(!std::isfinite(cumulativeLengths[i]) || (i == 0 ? cumulativeLengths[i] != 0 : cumulativeLengths[i] < cumulativeLengths[i - 1]))
+		{
+			throw std::runtime_error("Spline is corrupted, its cumulative lengths must be finite and increasing from 0.");
+		}
+		
+		if(!cumulativeLengthErrors.empty() && !(cumulativeLengthErrors[i] >= 0 && std::isfinite(cumulativeLengthErrors[i])))
+		{
+			throw std::runtime_error("Spline is corrupted, its length error estimates must be finite and positive.");
+		}
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::write(const std::string& fileName, const uint32_t& content, const T& speed, const T& duration,
+												 const T& tolerance) const
+{
+	if(parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot save empty spline. Use non-default constructor to provide points.");
+	}
+	
+	simplineInternal::FileHeader header = {};
+	std::copy(simplineInternal::fileMagic, simplineInternal::fileMagic + sizeof(header.magic), header.magic);
+	header.byteOrderTag = simplineInternal::fileByteOrderTag;
+	header.version = simplineInternal::fileVersion;
+	header.scalarSize = sizeof(T);
+	header.dimension = Dim;
+	header.content = content;
+	header.quadratureRule = quadrature.rule;
+	header.quadratureAbsoluteTolerance = quadrature.absoluteTolerance;
+	header.quadratureRelativeTolerance = quadrature.relativeTolerance;
+	header.speed = speed;
+	header.duration = duration;
+	header.tolerance = tolerance;
+	header.pointCount = parameterValues.size();
+	header.cumulativeLengthErrorCount = cumulativeLengthErrors.size();
+	
+	// every section starts on an aligned offset, the size of the file is the end of the last section
+	header.parameterValuesOffset = simplineInternal::alignFileOffset(sizeof(header));
+	header.segmentsOffset = simplineInternal::alignFileOffset(header.parameterValuesOffset + parameterValues.size() * sizeof(T));
+	header.cumulativeLengthsOffset = simplineInternal::alignFileOffset(header.segmentsOffset + segments.size() * sizeof(SegmentCoefficients));
+	header.cumulativeLengthErrorsOffset = simplineInternal::alignFileOffset(header.cumulativeLengthsOffset + cumulativeLengths.size() * sizeof(T));
+	header.headerChecksum = simplineInternal::computeHeaderChecksum(header);
+	
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if(!file)
+	{
+		throw std::runtime_error("Cannot open file " + fileName + ".");
+	}
+	
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	simplineInternal::writeFileSection(file, parameterValues.data(), header.parameterValuesOffset, parameterValues.size() * sizeof(T));
+	simplineInternal::writeFileSection(file, segments.data(), header.segmentsOffset, segments.size() * sizeof(SegmentCoefficients));
+	simplineInternal::writeFileSection(file, cumulativeLengths.data(), header.cumulativeLengthsOffset, cumulativeLengths.size() * sizeof(T));
+	simplineInternal::writeFileSection(file, cumulativeLengthErrors.data(), header.cumulativeLengthErrorsOffset, cumulativeLengthErrors.size() * sizeof(T));
+	
+	file.close();
+	if(!file)
+	{
+		throw std::runtime_error("Cannot write file " + fileName + ".");
+	}
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::ParametrizedSpline simpline<T, Dim>::ParametrizedSpline::read(const std::string& fileName, const uint32_t& content, T& speed,
+																						  T& duration, T& tolerance)
+{
+	uint64_t fileSize;
+	const std::shared_ptr<const void> mapping = simplineInternal::mapFile(fileName, fileSize);
+	const char* fileData = static_cast<const char*>(mapping.get());
+	
+	simplineInternal::FileHeader header;
+	std::memcpy(&header, fileData, sizeof(header));
+	if(!std::equal(header.magic, header.magic + sizeof(header.magic), simplineInternal::fileMagic))
+	{
+		throw std::runtime_error("File " + fileName + " does not contain a spline.");
+	}
+	
+	if(header.byteOrderTag != simplineInternal::fileByteOrderTag)
+	{
+		throw std::runtime_error("File " + fileName + " was saved on a machine of a different byte order.");
+	}
+	
+	if(header.version != simplineInternal::fileVersion)
+	{
+		throw std::runtime_error("File " + fileName + " has version " + std::to_string(header.version) + ", only version " +
+								 std::to_string(simplineInternal::fileVersion) + " is supported.");
+	}
+	
+	if(header.headerChecksum != simplineInternal::computeHeaderChecksum(header))
+	{
+		throw std::runtime_error("File " + fileName + " is corrupted, the checksum of its header does not match.");
+	}
+	
+	if(header.scalarSize != sizeof(T) || header.dimension != Dim)
+	{
+		throw std::runtime_error("File " + fileName + " contains a spline of dimension " + std::to_string(header.dimension) + " with " +
+								 std::to_string(header.scalarSize) + "-byte scalars, expected dimension " + std::to_string(Dim) + " with " +
+								 std::to_string(sizeof(T)) + "-byte scalars.");
+	}
+	
+	if(header.content != content)
+	{
+		throw std::runtime_error(content == simplineInternal::CONSTANT_SPEED_SPLINE_FILE ?
+								 "File " + fileName + " does not contain a constant-speed spline." :
+								 "File " + fileName + " does not contain a parametrized spline.");
+	}
+	
+	const uint64_t pointCount = header.pointCount;
+	const uint64_t errorCount = header.cumulativeLengthErrorCount;
+	const bool adaptive = header.quadratureRule == Quadrature::ADAPTIVE_GAUSS_KRONROD_15;
+	// counts larger than the file are rejected before they are multiplied by the sizes of the elements
+	if(pointCount < 2 || pointCount > fileSize / sizeof(SegmentCoefficients) || header.quadratureRule > Quadrature::ADAPTIVE_GAUSS_KRONROD_15 ||
+	   errorCount != (adaptive ? pointCount : 0))
+	{
+		throw std::runtime_error("File " + fileName + " is corrupted.");
+	}
+	
+	// same requirements as the constructors, not-a-number tolerances fail the comparisons
+	if(!(header.quadratureAbsoluteTolerance >= 0 && header.quadratureRelativeTolerance >= 0) ||
+	   (adaptive && header.quadratureAbsoluteTolerance == 0 && header.quadratureRelativeTolerance == 0))
+	{
+		throw std::runtime_error("File " + fileName + " is corrupted, its quadrature tolerances are invalid.");
+	}
+	
+	if(content == simplineInternal::CONSTANT_SPEED_SPLINE_FILE && !(header.speed > 0 && header.tolerance > 0 && std::isfinite(header.speed) &&
+																	std::isfinite(header.tolerance) && std::isfinite(header.duration)))
+	{
+		throw std::runtime_error("File " + fileName + " is corrupted, its speed, duration or tolerance is invalid.");
+	}
+	
+	// sections must be aligned for the coefficients to be read in place, and must lie within the file
+	const uint64_t sectionOffsets[] = {header.parameterValuesOffset, header.segmentsOffset, header.cumulativeLengthsOffset, header.cumulativeLengthErrorsOffset};
+	const uint64_t sectionSizes[] = {pointCount * sizeof(T), pointCount * sizeof(SegmentCoefficients), pointCount * sizeof(T), errorCount * sizeof(T)};
+	for(size_t i = 0; i < 4; i++)
+	{
+		if(sectionOffsets[i] % simplineInternal::fileSectionAlignment != 0 || sectionOffsets[i] > fileSize || sectionSizes[i] > fileSize - sectionOffsets[i])
+		{
+			throw std::runtime_error("File " + fileName + " is truncated or corrupted.");
+		}
+	}
+	
+	// the counts of parameter values, segments and cumulative lengths are all the point count, their values are only checked by validate()
+	const T* parameterValues = reinterpret_cast<const T*>(fileData + header.parameterValuesOffset);
+	const SegmentCoefficients* segments = reinterpret_cast<const SegmentCoefficients*>(fileData + header.segmentsOffset);
+	const T* cumulativeLengths = reinterpret_cast<const T*>(fileData + header.cumulativeLengthsOffset);
+	
+	ParametrizedSpline spline;
+	spline.parameterValues = simplineInternal::MappableVector<T>(parameterValues, pointCount, mapping);
+	spline.segments = simplineInternal::MappableVector<SegmentCoefficients>(segments, pointCount, mapping);
+	spline.cumulativeLengths = simplineInternal::MappableVector<T>(cumulativeLengths, pointCount, mapping);
+	spline.cumulativeLengthErrors = simplineInternal::MappableVector<T>(reinterpret_cast<const T*>(fileData + header.cumulativeLengthErrorsOffset), errorCount,
+																		mapping);
+	spline.quadrature.rule = static_cast<typename Quadrature::Rule>(header.quadratureRule);
+	spline.quadrature.absoluteTolerance = header.quadratureAbsoluteTolerance;
+	spline.quadrature.relativeTolerance = header.quadratureRelativeTolerance;
+	
+	speed = header.speed;
+	duration = header.duration;
+	tolerance = header.tolerance;
+	
+	return spline;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Statistics simpline<T, Dim>::ParametrizedSpline::getStatistics() const
+{
+#ifdef SIMPLINE_ENABLE_STATISTICS
+	return statisticsRecorder.getStatistics();
+#else
+	return Statistics();
+#endif
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::ParametrizedSpline::setTraceCallback(const TraceCallback& traceCallback)
+{
+#ifdef SIMPLINE_ENABLE_STATISTICS
+	statisticsRecorder.setTraceCallback(traceCallback);
+#else
+	(void)traceCallback;
+#endif
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef SIMPLINE_SERIALIZATION_H
+#define SIMPLINE_SERIALIZATION_H
+
+// files are memory-mapped where POSIX mappings are available, and otherwise read into memory, which can also be forced by defining
+// SIMPLINE_DISABLE_MEMORY_MAPPING
+#if !defined(SIMPLINE_DISABLE_MEMORY_MAPPING) && defined(__has_include)
+#if __has_include(<sys/mman.h>) && __has_include(<sys/stat.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#define SIMPLINE_MEMORY_MAPPING
+#endif
+#endif
+
+#ifdef SIMPLINE_MEMORY_MAPPING
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace simplineInternal
+{
+constexpr char fileMagic[8] = {'S', 'I', 'M', 'P', 'L', 'I', 'N', 'E'};
+
+// written in the byte order of the machine saving the file, it reads differently on machines of the other byte order
+constexpr uint32_t fileByteOrderTag = 0x01020304;
+
+constexpr uint32_t fileVersion = 2;
+
+// sections are aligned so that coefficients can be loaded with aligned SIMD instructions directly from the mapping
+constexpr uint64_t fileSectionAlignment = 64;
+
+enum FileContent : uint32_t
+{
+	PARAMETRIZED_SPLINE_FILE = 0,
+	CONSTANT_SPEED_SPLINE_FILE = 1
+};
+
+// scalars of the header are stored as doubles whatever the type of the spline, so that the header has the same layout for all types
+struct FileHeader
+{
+	char magic[8];
+	uint32_t byteOrderTag;
+	uint32_t version;
+	uint32_t scalarSize;
+	uint32_t dimension;
+	uint32_t content;
+	uint32_t quadratureRule;
+	double quadratureAbsoluteTolerance;
+	double quadratureRelativeTolerance;
+	double speed;
+	double duration;
+	double tolerance;
+	uint64_t pointCount;
+	uint64_t parameterValuesOffset;
+	uint64_t segmentsOffset;
+	uint64_t cumulativeLengthsOffset;
+	uint64_t cumulativeLengthErrorsOffset;
+	uint64_t cumulativeLengthErrorCount;
+	// checksum of the previous fields, loading only checks the header so that it does not depend on the size of the spline
+	uint64_t headerChecksum;
+};
+
+// 64-bit FNV-1a hash of the header without its checksum
+inline uint64_t computeHeaderChecksum(const FileHeader& header)
+{
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&header);
+	uint64_t checksum = 0xcbf29ce484222325;
+	for(size_t i = 0; i < offsetof(FileHeader, headerChecksum); i++)
+	{
+		checksum = (checksum ^ bytes[i]) * 0x100000001b3;
+	}
+	return checksum;
+}
+
+inline uint64_t alignFileOffset(const uint64_t& offset)
+{
+	return (offset + fileSectionAlignment - 1) / fileSectionAlignment * fileSectionAlignment;
+}
+
+inline void writeFileSection(std::ofstream& file, const void* data, const uint64_t& offset, const uint64_t& size)
+{
+	const uint64_t position = file.tellp();
+	const std::string padding(offset - position, '\0');
+	file.write(padding.data(), padding.size());
+	file.write(static_cast<const char*>(data), size);
+}
+
+#ifdef SIMPLINE_MEMORY_MAPPING
+// the whole file is mapped read-only, the mapping is released once the last spline using it is destroyed
+inline std::shared_ptr<const void> mapFile(const std::string& fileName, uint64_t& fileSize)
+{
+	const int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+	if(fileDescriptor < 0)
+	{
+		throw std::runtime_error("Cannot open file " + fileName + ".");
+	}
+	
+	struct stat fileStatus;
+	if(fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size < static_cast<off_t>(sizeof(FileHeader)))
+	{
+		close(fileDescriptor);
+		throw std::runtime_error("File " + fileName + " is too small to contain a spline.");
+	}
+	fileSize = fileStatus.st_size;
+	
+	void* address = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if(address == MAP_FAILED)
+	{
+		throw std::runtime_error("Cannot map file " + fileName + ".");
+	}
+	
+	const uint64_t mappingSize = fileSize;
+	return std::shared_ptr<const void>(address, [mappingSize](const void* mappedAddress)
+	{
+		munmap(const_cast<void*>(mappedAddress), mappingSize);
+	});
+}
+#else
+// the whole file is read into a buffer aligned like the sections of the file, which is shared by the splines using it as a mapping would be
+inline std::shared_ptr<const void> mapFile(const std::string& fileName, uint64_t& fileSize)
+{
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if(!file)
+	{
+		throw std::runtime_error("Cannot open file " + fileName + ".");
+	}
+	
+	const std::streamoff endPosition = file.tellg();
+	if(endPosition < static_cast<std::streamoff>(sizeof(FileHeader)))
+	{
+		throw std::runtime_error("File " + fileName + " is too small to contain a spline.");
+	}
+	fileSize = endPosition;
+	
+	const std::align_val_t alignment = static_cast<std::align_val_t>(fileSectionAlignment);
+	std::shared_ptr<void> buffer(::operator new(fileSize, alignment), [alignment](void* bufferAddress)
+	{
+		::operator delete(bufferAddress, alignment);
+	});
+	file.seekg(0);
+	if(!file.read(static_cast<char*>(buffer.get()), fileSize))
+	{
+		throw std::runtime_error("Cannot read file " + fileName + ".");
+	}
+	return buffer;
+}
+#endif
+}
+
+#endif
@@ -1,69 +1,867 @@
 #ifndef SIMPLINE_SIMPLINE_H
 #define SIMPLINE_SIMPLINE_H
 
+#include "ThreadPool.h"
+#include "MappableVector.h"
 #include <Eigen/Dense>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
 #include <vector>
+#include <string>
 #include <map>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
 
-template<typename T>
+template<typename T, int Dim = 3>
 struct simpline
 {
-	typedef typename Eigen::Matrix<T, 3, 1> Vector3;
+	typedef typename Eigen::Matrix<T, Dim, 1> Vector;
 	typedef typename Eigen::Matrix<T, Eigen::Dynamic, 1> VectorX;
+	typedef typename Eigen::Matrix<T, Dim, Eigen::Dynamic> Matrix;
+	// coefficients of a cubic segment in increasing powers of the parameter value relative to the start of the segment
+	typedef typename Eigen::Matrix<T, Dim, 4> SegmentCoefficients;
+	typedef SimplineThreadPool ThreadPool;
+	// names of the point and matrix types from before points had a dimension, they are the same types as Vector and Matrix for 3D splines
+	typedef typename Eigen::Matrix<T, 3, 1> Vector3 [[deprecated("Use Vector instead.")]];
+	typedef typename Eigen::Matrix<T, 3, Eigen::Dynamic> Matrix3X [[deprecated("Use Matrix instead.")]];
+	
+	class ParametrizedSpline;
+	
+	class ConstantSpeedSpline;
+	
+	class KnotBasis;
+	
+	class SplineBatch;
+	
+	class BakedSpline;
+	
+	class SplineBuilder;
+	
+	class SplineHandle;
+	
+	class StatisticsScope;
+	
+	// derivatives are taken with respect to the variable of the spline (parameter value or time)
+	// curvature and Frenet frame are left to zero unless requested, normal and binormal are also zero where the curvature is zero
+	// binormal is only computed in three dimensions
+	struct State
+	{
+		Vector value;
+		Vector velocity;
+		Vector acceleration;
+		T curvature;
+		Vector tangent;
+		Vector normal;
+		Vector binormal;
+	};
+	
+	// result of the evaluations for real-time loops, which neither allocate nor throw, values out of the spline are clamped to its ends and the outputs
+	// are left untouched for empty splines and not-a-number inputs
+	enum Status
+	{
+		SUCCESS,
+		CLAMPED,
+		EMPTY_SPLINE,
+		INVALID_ARGUMENT
+	};
+	
+	// closest point of a spline to a queried point, the time of parametrized splines is their parameter value
+	struct Projection
+	{
+		T parameterValue;
+		T time;
+		Vector point;
+		T distance;
+	};
+	
+	// fixed Gauss-Legendre rules evaluate the gradient a fixed number of times per segment and do not estimate their error, the adaptive
+	// Gauss-Kronrod rule bisects segments until the estimated error is below one of the tolerances
+	struct Quadrature
+	{
+		enum Rule
+		{
+			GAUSS_LEGENDRE_5,
+			GAUSS_LEGENDRE_7,
+			GAUSS_LEGENDRE_25,
+			ADAPTIVE_GAUSS_KRONROD_15
+		};
+		
+		Rule rule = GAUSS_LEGENDRE_25;
+		T absoluteTolerance = 0;
+		T relativeTolerance = 1e-6;
+	};
+	
+	// work done by a spline, which is only counted when the library and its users are compiled with SIMPLINE_ENABLE_STATISTICS, times are in seconds
+	// and those of the knot sorting and factorization are the ones of the basis the spline was built on
+	struct Statistics
+	{
+		// parallel evaluations count one evaluation per chunk
+		uint64_t evaluationCount = 0;
+		uint64_t segmentSearchCount = 0;
+		uint64_t scannedSegmentCount = 0;
+		uint64_t rootFindingCount = 0;
+		uint64_t rootFindingIterationCount = 0;
+		uint64_t quadratureCount = 0;
+		uint64_t gradientEvaluationCount = 0;
+		double sortingTime = 0;
+		double factorizationTime = 0;
+		double solvingTime = 0;
+		double lengthIntegrationTime = 0;
+		double parametrizationTime = 0;
+		
+		Statistics& operator+=(const Statistics& other);
+	};
+	
+	// reported after each evaluation and construction phase with the statistics of this call alone, evaluations are only timed when a callback is set
+	struct TraceEvent
+	{
+		const char* operation;
+		Statistics statistics;
+		double duration;
+	};
+	
+	// called from the threads doing the work, it must be thread-safe when splines are evaluated in parallel and must not throw
+	typedef std::function<void(const TraceEvent&)> TraceCallback;
+	
+	// statistics of a spline, whose counters can be updated by concurrent evaluations
+	class StatisticsRecorder
+	{
+	public:
+		StatisticsRecorder();
+		
+		StatisticsRecorder(const StatisticsRecorder& other);
+		
+		StatisticsRecorder& operator=(const StatisticsRecorder& other);
+		
+		Statistics getStatistics() const;
+		
+		void add(const Statistics& statistics);
+		
+		void setTraceCallback(const TraceCallback& traceCallback);
+	
+	private:
+		void addCounters(const Statistics& statistics);
+		
+		// times are only added by construction phases, which do not run concurrently
+		void addTimes(const Statistics& statistics);
+		
+		std::atomic<uint64_t> evaluationCount;
+		std::atomic<uint64_t> segmentSearchCount;
+		std::atomic<uint64_t> scannedSegmentCount;
+		std::atomic<uint64_t> rootFindingCount;
+		std::atomic<uint64_t> rootFindingIterationCount;
+		std::atomic<uint64_t> quadratureCount;
+		std::atomic<uint64_t> gradientEvaluationCount;
+		double sortingTime;
+		double factorizationTime;
+		double solvingTime;
+		double lengthIntegrationTime;
+		double parametrizationTime;
+		TraceCallback traceCallback;
+		
+		friend class StatisticsScope;
+	};
+	
+	// attributes the work counted by the calling thread during its lifetime to a recorder, scopes opened within another one on the same thread do nothing
+	// so that work is only counted once
+	class StatisticsScope
+	{
+	public:
+		// construction phases are timed in the given field, evaluations have no field and counting scopes have neither an operation nor a field
+		StatisticsScope(StatisticsRecorder& recorder, const char* operation, double Statistics::* time);
+		
+		~StatisticsScope();
+		
+		StatisticsScope(const StatisticsScope&) = delete;
+		
+		StatisticsScope& operator=(const StatisticsScope&) = delete;
+	
+	private:
+		StatisticsRecorder* recorder;
+		const char* operation;
+		double Statistics::* time;
+		bool outermost;
+		bool timed;
+		Statistics startCounters;
+		std::chrono::steady_clock::time_point startTime;
+	};
+	
+	class SplineCursor
+	{
+	public:
+		SplineCursor();
+	
+	private:
+		size_t segmentIndex;
+		// last arc length inversion, used to warm start the next one when it falls in the same segment
+		size_t anchorSegmentIndex;
+		T anchorParameterValue;
+		T anchorLength;
+		
+		friend class ParametrizedSpline;
+		friend class ConstantSpeedSpline;
+		friend class SplineBatch;
+	};
+	
+	// sorted parameter values and factored natural spline system, shared by parametrized splines built on the same knots such as trajectories sampled at
+	// the same times, only the right-hand sides are then solved for their points
+	class KnotBasis
+	{
+	public:
+		explicit KnotBasis(const std::vector<T>& parameterValues);
+		
+		size_t size() const;
+		
+		// one spline per point set, all of them sharing the factorization
+		std::vector<ParametrizedSpline> createSplines(const std::vector<std::vector<simpline<T, Dim>::Vector>>& pointSets) const;
+		
+		std::vector<ParametrizedSpline> createSplines(const std::vector<std::vector<simpline<T, Dim>::Vector>>& pointSets, const Quadrature& quadrature) const;
+		
+		// splines are solved in parallel
+		std::vector<ParametrizedSpline> createSplines(const std::vector<std::vector<simpline<T, Dim>::Vector>>& pointSets, const Quadrature& quadrature,
+													  ThreadPool& threadPool) const;
+	
+	private:
+		std::vector<ParametrizedSpline> createSplines(const std::vector<std::vector<simpline<T, Dim>::Vector>>& pointSets, const Quadrature& quadrature,
+													  ThreadPool* threadPool) const;
+		
+		// index of each sorted parameter value in the unsorted ones
+		std::vector<size_t> sortedIndices;
+		std::vector<T> parameterValues;
+		std::vector<T> lowerDiagonal;
+		std::vector<T> upperFactors;
+		std::vector<T> inversePivots;
+#ifdef SIMPLINE_ENABLE_STATISTICS
+		StatisticsRecorder statisticsRecorder;
+#endif
+		
+		friend class ParametrizedSpline;
+	};
 	
 	class ParametrizedSpline
 	{
 	public:
 		ParametrizedSpline();
 		
-		ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T>::Vector3>& points);
+		ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T, Dim>::Vector>& points);
+		
+		ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T, Dim>::Vector>& points, const Quadrature& quadrature);
+		
+		// segments are updated in parallel, second derivatives are still solved serially
+		ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T, Dim>::Vector>& points, const Quadrature& quadrature,
+						   ThreadPool& threadPool);
+		
+		// the segments and arc length tables are allocated from the memory resource, which must outlive the spline and its moved-to instances,
+		// copies and temporary buffers of the construction use the default resource
+		ParametrizedSpline(const std::vector<T>& parameterValues, const std::vector<simpline<T, Dim>::Vector>& points, const Quadrature& quadrature,
+						   std::pmr::memory_resource* memoryResource);
+		
+		// points are given in the order of the parameter values the basis was built from
+		ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points);
+		
+		ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points, const Quadrature& quadrature);
+		
+		ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points, const Quadrature& quadrature, ThreadPool& threadPool);
+		
+		ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points, const Quadrature& quadrature,
+						   std::pmr::memory_resource* memoryResource);
 		
-		simpline<T>::Vector3 getValue(const T& parameterValue) const;
+		simpline<T, Dim>::Vector getValue(const T& parameterValue) const;
 		
-		simpline<T>::Vector3 getGradient(const T& parameterValue) const;
+		simpline<T, Dim>::Vector getValue(const T& parameterValue, SplineCursor& cursor) const;
+		
+		simpline<T, Dim>::Vector getGradient(const T& parameterValue) const;
+		
+		simpline<T, Dim>::Vector getGradient(const T& parameterValue, SplineCursor& cursor) const;
+		
+		// values and gradients are Dim x count column-major buffers (same layout as Matrix::data()), either of them can be null
+		void evaluate(const T* queriedParameterValues, const size_t& count, T* values, T* gradients) const;
+		
+		void evaluate(const T* queriedParameterValues, const size_t& count, T* values, T* gradients, SplineCursor& cursor) const;
+		
+		void evaluate(const T* queriedParameterValues, const size_t& count, T* values, T* gradients, ThreadPool& threadPool) const;
+		
+		State evaluateState(const T& parameterValue, const bool& withFrenetFrame = false) const;
+		
+		State evaluateState(const T& parameterValue, SplineCursor& cursor, const bool& withFrenetFrame = false) const;
+		
+		// O(log n) segment search followed by the evaluation of a single cubic segment
+		Status tryGetValue(const T& parameterValue, simpline<T, Dim>::Vector& value, SplineCursor& cursor) const noexcept;
+		
+		Status tryGetGradient(const T& parameterValue, simpline<T, Dim>::Vector& gradient, SplineCursor& cursor) const noexcept;
+		
+		Status tryEvaluateState(const T& parameterValue, State& state, SplineCursor& cursor, const bool& withFrenetFrame = false) const noexcept;
 		
 		T getLength() const;
 		
 		T getLength(const T& startParameterValue, const T& endParameterValue) const;
+		
+		// error estimates are not a number with fixed quadrature rules
+		T getLength(const T& startParameterValue, const T& endParameterValue, T& errorEstimate) const;
+		
+		T getLengthErrorEstimate() const;
+		
+		// inverse of the arc length, the tolerance applies to the returned parameter value
+		T getParameterValue(const T& length, const T& tolerance) const;
+		
+		T getParameterValue(const T& length, const T& tolerance, SplineCursor& cursor) const;
+		
+		// only second derivatives of a trailing window, sized so that the error of the truncation is below the decay tolerance (relative to the
+		// change of second derivative at the previous last point), are solved again, cursors used before must be reset
+		// the spline is left unchanged when the points or the decay tolerance are rejected
+		void appendPoints(const std::vector<T>& newParameterValues, const std::vector<simpline<T, Dim>::Vector>& newPoints);
+		
+		void appendPoints(const std::vector<T>& newParameterValues, const std::vector<simpline<T, Dim>::Vector>& newPoints, const T& decayTolerance);
+		
+		// points are indexed by increasing parameter value and keep their parameter value, only segments in a window around them are updated
+		// the spline is left unchanged when the points or the decay tolerance are rejected
+		void movePoint(const size_t& pointIndex, const simpline<T, Dim>::Vector& newPoint);
+		
+		void movePoint(const size_t& pointIndex, const simpline<T, Dim>::Vector& newPoint, const T& decayTolerance);
+		
+		void replaceRange(const size_t& firstPointIndex, const std::vector<simpline<T, Dim>::Vector>& newPoints);
+		
+		void replaceRange(const size_t& firstPointIndex, const std::vector<simpline<T, Dim>::Vector>& newPoints, const T& decayTolerance);
+		
+		// versioned binary format holding the solved segments and the arc length table, files must be loaded on machines of the same byte order
+		// into splines of the same type and dimension
+		void save(const std::string& fileName) const;
+		
+		// the file is memory-mapped and evaluated in place (read into memory where mappings are not available), modifying the spline copies its data
+		// first, loading only checks the header so that it takes the same time whatever the size of the spline
+		static ParametrizedSpline load(const std::string& fileName);
+		
+		// reads the whole spline to reject corrupted data, such as parameter values that are not finite and strictly increasing, which loading does
+		// not check
+		void validate() const;
+		
+		// searches a hierarchy of bounding boxes of the segments, built on the first projection after the spline was created or modified
+		Projection project(const simpline<T, Dim>::Vector& point) const;
+		
+		// the segment of the previous projection is searched first, which prunes most of the hierarchy when the point moved little since then
+		Projection project(const simpline<T, Dim>::Vector& point, SplineCursor& cursor) const;
+		
+		// snapshot of the work done since the spline was built, all zero without SIMPLINE_ENABLE_STATISTICS
+		Statistics getStatistics() const;
+		
+		void setTraceCallback(const TraceCallback& traceCallback);
 	
 	private:
-		simpline<T>::Vector3 computeFiniteDifference(const size_t& startPointIndex, const size_t& endPointIndex);
+		struct BoundingBox
+		{
+			Vector minimum;
+			Vector maximum;
+		};
 		
-		std::vector<T> parameterValues;
-		std::vector<simpline<T>::Vector3> points;
-		std::vector<simpline<T>::Vector3> firstDerivatives;
-		std::vector<simpline<T>::Vector3> secondDerivatives;
-		std::vector<simpline<T>::Vector3> thirdDerivatives;
-		std::map<std::pair<size_t, size_t>, simpline<T>::Vector3> finiteDifferences;
+		// levels of a binary tree, the first level bounds groups of consecutive segments and each box of the next levels bounds two boxes of the
+		// previous level, up to a single box bounding the whole spline
+		typedef std::vector<std::vector<BoundingBox>> BoundingVolumeHierarchy;
+		
+		ParametrizedSpline(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points, const Quadrature& quadrature, ThreadPool* threadPool,
+						   std::pmr::memory_resource* memoryResource);
+		
+		// sorts the points and allocates the segments, without solving them
+		void initialize(const KnotBasis& basis, const std::vector<simpline<T, Dim>::Vector>& points, const Quadrature& quadrature,
+						std::pmr::memory_resource* memoryResource);
+		
+		void solveSegments(const KnotBasis& basis, ThreadPool* threadPool);
+		
+		size_t findSegmentIndex(const T& parameterValue) const;
+		
+		size_t findSegmentIndex(const T& parameterValue, const SplineCursor& cursor) const;
+		
+		simpline<T, Dim>::Vector computeValue(const size_t& segmentIndex, const T& parameterValue) const;
+		
+		simpline<T, Dim>::Vector computeGradient(const size_t& segmentIndex, const T& parameterValue) const;
+		
+		simpline<T, Dim>::Vector computeSecondDerivative(const size_t& segmentIndex, const T& parameterValue) const;
+		
+		State computeState(const size_t& segmentIndex, const T& parameterValue, const bool& withFrenetFrame) const;
+		
+		Status clampParameterValue(const T& parameterValue, T& clampedParameterValue) const noexcept;
+		
+		T computeLength(const size_t& segmentIndex, const T& startParameterValue, const T& endParameterValue, T& errorEstimate) const;
+		
+		T integrateLength(const size_t& segmentIndex, const T& startParameterValue, const T& endParameterValue, T& errorEstimate) const;
+		
+		void solveSecondDerivatives(const size_t& firstPointIndex, const size_t& lastPointIndex);
+		
+		void updateSegments(const size_t& firstPointIndex, const size_t& lastPointIndex, ThreadPool* threadPool);
+		
+		void solveWindow(const size_t& firstChangedPointIndex, const size_t& lastChangedPointIndex, const size_t& windowSize);
+		
+		BoundingBox computeSegmentBoundingBox(const size_t& segmentIndex) const;
+		
+		std::shared_ptr<const BoundingVolumeHierarchy> getBoundingVolumeHierarchy() const;
+		
+		void projectOnSegment(const size_t& segmentIndex, const simpline<T, Dim>::Vector& point, T& parameterValue, T& squaredDistance) const;
+		
+		size_t projectOnSpline(const simpline<T, Dim>::Vector& point, const size_t& hintSegmentIndex, T& parameterValue, T& squaredDistance) const;
+		
+		// searches the segments from the first to the last one without the hierarchy, for windows of a few segments
+		size_t projectOnSegments(const simpline<T, Dim>::Vector& point, const size_t& firstSegmentIndex, const size_t& lastSegmentIndex, T& parameterValue,
+								 T& squaredDistance) const;
+		
+		void write(const std::string& fileName, const uint32_t& content, const T& speed, const T& duration, const T& tolerance) const;
+		
+		static ParametrizedSpline read(const std::string& fileName, const uint32_t& content, T& speed, T& duration, T& tolerance);
+		
+		simplineInternal::MappableVector<T> parameterValues;
+		// one contiguous record per segment so that an evaluation reads a single one, points and second derivatives are their first and third
+		// columns (up to a factor of 2), the record after the last segment only holds the last point and its second derivative
+		simplineInternal::MappableVector<SegmentCoefficients> segments;
+		simplineInternal::MappableVector<T> cumulativeLengths;
+		// only kept for the adaptive quadrature rule, fixed rules have no error estimates
+		simplineInternal::MappableVector<T> cumulativeLengthErrors;
+		Quadrature quadrature;
+		// built lazily by concurrent projections and dropped when segments are updated
+		mutable std::shared_ptr<const BoundingVolumeHierarchy> boundingVolumeHierarchy;
+#ifdef SIMPLINE_ENABLE_STATISTICS
+		mutable StatisticsRecorder statisticsRecorder;
+#endif
+		
+		friend class ConstantSpeedSpline;
+		friend class SplineBatch;
+		friend class KnotBasis;
+		friend class BakedSpline;
+		friend class SplineHandle;
 	};
 	
 	class ConstantSpeedSpline
 	{
 	public:
+		// walks the spline from time 0 to its duration at a fixed time step, each sample being warm started from the previous one
+		class Sampler
+		{
+		public:
+			Sampler(const ConstantSpeedSpline& spline, const T& timeStep);
+			
+			bool next(State& state, const bool& withFrenetFrame = false);
+			
+			T getTime() const;
+		
+		private:
+			const ConstantSpeedSpline* spline;
+			T timeStep;
+			size_t sampleIndex;
+			SplineCursor cursor;
+		};
+		
 		ConstantSpeedSpline();
 		
-		ConstantSpeedSpline(const std::vector<simpline<T>::Vector3>& points, const T& speed);
+		ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed);
+		
+		ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance);
+		
+		ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance, const Quadrature& quadrature);
+		
+		ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance, const Quadrature& quadrature,
+							ThreadPool& threadPool);
+		
+		// same lifetime requirements as the memory resources of the parametrized splines
+		ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance, const Quadrature& quadrature,
+							std::pmr::memory_resource* memoryResource);
+		
+		simpline<T, Dim>::Vector getValue(const T& time) const;
+		
+		simpline<T, Dim>::Vector getValue(const T& time, SplineCursor& cursor) const;
+		
+		simpline<T, Dim>::Vector getGradient(const T& time) const;
+		
+		simpline<T, Dim>::Vector getGradient(const T& time, SplineCursor& cursor) const;
+		
+		// values and gradients are Dim x count column-major buffers (same layout as Matrix::data()), either of them can be null
+		// batches are split in chunks of fixed size which do not warm start from each other, so that they can be evaluated in parallel with the
+		// same results
+		void evaluate(const T* times, const size_t& count, T* values, T* gradients) const;
 		
-		simpline<T>::Vector3 getValue(const T& time) const;
+		void evaluate(const T* times, const size_t& count, T* values, T* gradients, SplineCursor& cursor) const;
 		
-		simpline<T>::Vector3 getGradient(const T& time) const;
+		void evaluate(const T* times, const size_t& count, T* values, T* gradients, ThreadPool& threadPool) const;
+		
+		// solves the parameter value once for value, velocity and acceleration
+		State evaluateState(const T& time, const bool& withFrenetFrame = false) const;
+		
+		State evaluateState(const T& time, SplineCursor& cursor, const bool& withFrenetFrame = false) const;
+		
+		void evaluateStates(const T* times, const size_t& count, State* states, const bool& withFrenetFrame = false) const;
+		
+		void evaluateStates(const T* times, const size_t& count, State* states, SplineCursor& cursor, const bool& withFrenetFrame = false) const;
+		
+		void evaluateStates(const T* times, const size_t& count, State* states, ThreadPool& threadPool, const bool& withFrenetFrame = false) const;
+		
+		// worst case of an evaluation: an O(log n) segment search, then at most maximumRootFindingIterations (64) Newton steps, each of them
+		// integrating the gradient norm with 5, 7 or 25 gradient evaluations for the fixed quadrature rules, or up to 2047 Gauss-Kronrod rules of 15
+		// evaluations for the adaptive rule, which is not suited to real-time loops, and a few more gradient evaluations
+		Status tryGetValue(const T& time, simpline<T, Dim>::Vector& value, SplineCursor& cursor) const noexcept;
+		
+		Status tryGetGradient(const T& time, simpline<T, Dim>::Vector& gradient, SplineCursor& cursor) const noexcept;
+		
+		Status tryEvaluateState(const T& time, State& state, SplineCursor& cursor, const bool& withFrenetFrame = false) const noexcept;
 		
 		T getLength() const;
 		
 		T getLength(const T& startTime, const T& endTime) const;
 		
+		T getLengthErrorEstimate() const;
+		
 		T getSpeed() const;
 		
 		T getDuration() const;
+		
+		Sampler sampler(const T& timeStep) const;
+		
+		// the spline is left unchanged when the points or the decay tolerance are rejected
+		void appendPoints(const std::vector<simpline<T, Dim>::Vector>& points);
+		
+		void appendPoints(const std::vector<simpline<T, Dim>::Vector>& points, const T& decayTolerance);
+		
+		// parameter values of the following points are shifted by the change of chord length, their segments being otherwise untouched
+		// the spline is left unchanged when the points or the decay tolerance are rejected
+		void movePoint(const size_t& pointIndex, const simpline<T, Dim>::Vector& newPoint);
+		
+		void movePoint(const size_t& pointIndex, const simpline<T, Dim>::Vector& newPoint, const T& decayTolerance);
+		
+		void replaceRange(const size_t& firstPointIndex, const std::vector<simpline<T, Dim>::Vector>& newPoints);
+		
+		void replaceRange(const size_t& firstPointIndex, const std::vector<simpline<T, Dim>::Vector>& newPoints, const T& decayTolerance);
+		
+		// same format as the parametrized splines, with the speed, duration and tolerance
+		void save(const std::string& fileName) const;
+		
+		static ConstantSpeedSpline load(const std::string& fileName);
+		
+		void validate() const;
+		
+		Projection project(const simpline<T, Dim>::Vector& point) const;
+		
+		Projection project(const simpline<T, Dim>::Vector& point, SplineCursor& cursor) const;
+		
+		// includes the work done by the underlying parametrized spline
+		Statistics getStatistics() const;
+		
+		void setTraceCallback(const TraceCallback& traceCallback);
 	
 	private:
-		T computeParameterValue(const T& time) const;
+		ConstantSpeedSpline(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance, const Quadrature& quadrature,
+							ThreadPool* threadPool, std::pmr::memory_resource* memoryResource);
+		
+		// the time must be within the spline
+		T computeParameterValue(const T& time, SplineCursor& cursor) const noexcept;
+		
+		// converts derivatives with respect to the parameter value to time derivatives
+		void convertState(State& state) const noexcept;
+		
+		// time of a projection, the cursor is left on the segment of the projection
+		T computeProjectionTime(const T& parameterValue, SplineCursor& cursor) const;
+		
+		// closest point within replanProjectionWindowSegmentCount segments of the one at the given arc length, returns false when it lies at an end of
+		// the window within the spline, the pass of the spline closest to the point then continues out of the window
+		bool projectNearLength(const simpline<T, Dim>::Vector& point, const T& length, Projection& projection) const;
+		
+		Status clampTime(const T& time, T& clampedTime) const noexcept;
 		
-		std::map<T, T> timeParameterValues;
 		ParametrizedSpline parametrizedSpline;
 		T speed;
 		T duration;
+		T tolerance;
+#ifdef SIMPLINE_ENABLE_STATISTICS
+		mutable StatisticsRecorder statisticsRecorder;
+#endif
+		
+		friend class SplineBatch;
+		friend class BakedSpline;
+		friend class SplineHandle;
+	};
+	
+	// constant-speed spline resampled on a uniform time grid, each interval being the cubic Hermite interpolation of the values and gradients at its
+	// ends, so that evaluations only compute the index of their interval instead of searching segments and inverting the arc length
+	class BakedSpline
+	{
+	public:
+		BakedSpline();
+		
+		// the time step is refined until the largest error measured within the intervals is below the tolerance, errors are measured against fresh
+		// evaluations of the spline, which are only as accurate as its tolerance
+		// throws when the error stops decreasing before it reaches the tolerance, or when reaching the tolerance would need more intervals than
+		// maximumBakedIntervalCount even at the convergence order of the interpolation
+		BakedSpline(const ConstantSpeedSpline& spline, const T& tolerance);
+		
+		// the spline is sampled in parallel
+		BakedSpline(const ConstantSpeedSpline& spline, const T& tolerance, ThreadPool& threadPool);
+		
+		simpline<T, Dim>::Vector getValue(const T& time) const;
+		
+		simpline<T, Dim>::Vector getGradient(const T& time) const;
+		
+		// values and gradients are Dim x count column-major buffers, either of them can be null
+		void evaluate(const T* times, const size_t& count, T* values, T* gradients) const;
+		
+		T getDuration() const;
+		
+		T getTimeStep() const;
+		
+		// largest distance to the values of the spline, measured at a quarter, half and three quarters of every interval
+		T getMaximumError() const;
+		
+		// gradients are interpolated with one order of accuracy less than values
+		T getMaximumGradientError() const;
+		
+		// bytes used by the interpolation coefficients
+		size_t getMemoryUsage() const;
+	
+	private:
+		BakedSpline(const ConstantSpeedSpline& spline, const T& tolerance, ThreadPool* threadPool);
+		
+		void sample(const ConstantSpeedSpline& spline, const size_t& intervalCount, ThreadPool* threadPool);
+		
+		void measureError(const ConstantSpeedSpline& spline, ThreadPool* threadPool);
+		
+		static void evaluateSamples(const ConstantSpeedSpline& spline, const std::vector<T>& times, std::vector<T>& values, std::vector<T>& gradients,
+									ThreadPool* threadPool);
+		
+		size_t findIntervalIndex(const T& time) const;
+		
+		// coefficients in increasing powers of the time relative to the start of the interval
+		simplineInternal::AlignedVector<SegmentCoefficients> intervals;
+		T timeStep;
+		T inverseTimeStep;
+		T duration;
+		T maximumError;
+		T maximumGradientError;
+	};
+	
+	// constant-speed splines evaluated together at the same time, such as the trajectories of many agents, their segments and arc length tables are
+	// appended to arrays shared by all of them and each of them keeps the cursor of its previous evaluation, the segments of the cursors are also kept
+	// in columns across splines, so that the arc length inversions and the evaluations of blocks of splines are vectorized across them
+	class SplineBatch
+	{
+	public:
+		SplineBatch();
+		
+		// the spline is copied, the returned identifier stays valid until it is removed
+		size_t add(const ConstantSpeedSpline& spline);
+		
+		// the data of removed splines is left in the shared arrays until it outweighs the data of the remaining ones
+		void remove(const size_t& identifier);
+		
+		size_t size() const;
+		
+		// identifiers of the splines in the order in which they are evaluated, removing a spline moves the last one to its place
+		const std::vector<size_t>& getIdentifiers() const;
+		
+		// values and gradients are Dim x size() column-major buffers, either of them can be null, splines shorter than the time are evaluated at their
+		// end
+		void evaluate(const T& time, T* values, T* gradients);
+		
+		void evaluate(const T& time, T* values, T* gradients, ThreadPool& threadPool);
+		
+		// work done by the evaluations of the batch, the statistics of the added splines are not carried over
+		Statistics getStatistics() const;
+		
+		void setTraceCallback(const TraceCallback& traceCallback);
+	
+	private:
+		// splines are evaluated in lanes by blocks of evaluationBlockSize, first being a multiple of it
+		void evaluateSplines(const size_t& first, const size_t& last, const T& time, T* values, T* gradients);
+		
+		void loadSegment(const size_t& splineIndex, const size_t& segmentIndex);
+		
+		void compact();
+		
+		// shared by all splines
+		std::vector<T> parameterValues;
+		simplineInternal::AlignedVector<SegmentCoefficients> segments;
+		std::vector<T> cumulativeLengths;
+		size_t removedPointCount;
+		
+		// one item per spline, in the order of the evaluations
+		std::vector<size_t> identifiers;
+		std::vector<size_t> firstPointIndices;
+		std::vector<size_t> pointCounts;
+		std::vector<T> speeds;
+		std::vector<T> durations;
+		std::vector<T> tolerances;
+		std::vector<Quadrature> quadratures;
+		std::vector<SplineCursor> cursors;
+		// coefficients of the segment of the cursor of each spline, one row per spline and one column per axis and power (4 * axis + power), so
+		// that each column is contiguous across splines, rows are allocated by blocks of evaluationBlockSize and those past the last spline are zero
+		Eigen::Array<T, Eigen::Dynamic, 4 * Dim> cursorSegments;
+		
+		// position of the splines in the previous arrays by identifier, identifiers of removed splines are reused
+		std::vector<size_t> splineIndices;
+		std::vector<size_t> freeIdentifiers;
+#ifdef SIMPLINE_ENABLE_STATISTICS
+		StatisticsRecorder statisticsRecorder;
+#endif
+	};
+	
+	// builds constant-speed splines on a background thread, one at a time in the order in which they were requested, so that replanning does not
+	// stall the thread evaluating the current spline, errors of the constructors are rethrown by the futures
+	class SplineBuilder
+	{
+	public:
+		SplineBuilder();
+		
+		// builds requested before the destruction are completed first
+		~SplineBuilder();
+		
+		SplineBuilder(const SplineBuilder&) = delete;
+		
+		SplineBuilder& operator=(const SplineBuilder&) = delete;
+		
+		// the points are copied
+		std::future<ConstantSpeedSpline> build(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed);
+		
+		std::future<ConstantSpeedSpline> build(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance);
+		
+		std::future<ConstantSpeedSpline> build(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance,
+											   const Quadrature& quadrature);
+		
+		// the thread pool must outlive the build
+		std::future<ConstantSpeedSpline> build(const std::vector<simpline<T, Dim>::Vector>& points, const T& speed, const T& tolerance,
+											   const Quadrature& quadrature, ThreadPool& threadPool);
+	
+	private:
+		std::future<ConstantSpeedSpline> enqueue(std::packaged_task<ConstantSpeedSpline()>&& task);
+		
+		void work();
+		
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::packaged_task<ConstantSpeedSpline()>> tasks;
+		bool stopping;
+		std::thread worker;
+	};
+	
+	// latest version of a trajectory, published by a writer thread and evaluated by reader threads on a common clock, a version maps the clock
+	// time to the time of its spline by subtracting its time offset
+	// readers never wait, allocate or free memory: they pin the sequence number of the version they read, and replaced versions are freed by the
+	// writer once no reader has them pinned
+	class SplineHandle
+	{
+	public:
+		// evaluation state of one reader thread, registering and unregistering take a lock and belong outside of real-time loops
+		class Reader
+		{
+		public:
+			// the handle must outlive the reader
+			explicit Reader(SplineHandle& handle);
+			
+			~Reader();
+			
+			Reader(const Reader&) = delete;
+			
+			Reader& operator=(const Reader&) = delete;
+			
+			// the time is on the clock of the handle, times outside of the published spline are clamped to it
+			// EMPTY_SPLINE is returned before the first version is published
+			Status tryGetValue(const T& time, simpline<T, Dim>::Vector& value) noexcept;
+			
+			Status tryGetGradient(const T& time, simpline<T, Dim>::Vector& gradient) noexcept;
+			
+			Status tryEvaluateState(const T& time, State& state, const bool& withFrenetFrame = false) noexcept;
+			
+			// sequence number of the version used by the last evaluation, 0 before the first one
+			uint64_t getSequenceNumber() const noexcept;
+		
+		private:
+			template<typename Evaluation>
+			Status read(const T& time, const Evaluation& evaluation) noexcept;
+			
+			struct alignas(64) Slot
+			{
+				// sequence number below which the reader uses no version, the maximum value when it is not reading
+				std::atomic<uint64_t> pinnedSequenceNumber;
+				// clock time of the latest evaluation, from which new versions are continued
+				std::atomic<T> time;
+			};
+			
+			SplineHandle* handle;
+			std::unique_ptr<Slot> slot;
+			// belongs to the version of the sequence number
+			SplineCursor cursor;
+			uint64_t sequenceNumber;
+			
+			friend class SplineHandle;
+		};
+		
+		SplineHandle();
+		
+		// the readers must be destroyed first
+		~SplineHandle();
+		
+		SplineHandle(const SplineHandle&) = delete;
+		
+		SplineHandle& operator=(const SplineHandle&) = delete;
+		
+		// the new version continues from the position of the readers: the value of the current version at the latest time evaluated by a reader is
+		// projected on the new spline and the time of the projection is aligned with that clock time, the first version starts at that clock time
+		// the projection is searched near the arc length reached by the readers on the current version, so that new versions sharing its start
+		// but looping back or crossing themselves do not move the readers to another pass, the whole spline is only searched when the readers are
+		// not within that window
+		// returns the sequence number of the new version, versions are numbered from 1
+		uint64_t publish(const ConstantSpeedSpline& spline);
+		
+		// the new version starts at the given clock time
+		uint64_t publish(const ConstantSpeedSpline& spline, const T& startTime);
+		
+		// 0 before the first version is published
+		uint64_t getSequenceNumber() const;
+		
+		// clock time at which the spline of the current version starts
+		T getStartTime() const;
+		
+		// versions kept for readers which have not finished evaluating them, including the current one
+		size_t getVersionCount() const;
+	
+	private:
+		struct Version
+		{
+			ConstantSpeedSpline spline;
+			T timeOffset;
+			uint64_t sequenceNumber;
+		};
+		
+		// the lock must be held
+		uint64_t publishVersion(const ConstantSpeedSpline& spline, const T& timeOffset);
+		
+		// the lock must be held
+		T getLatestReaderTime() const;
+		
+		// the lock must be held
+		void freeVersions();
+		
+		// the version is stored before its sequence number, so that a reader loading a sequence number then the version gets at least that version
+		std::atomic<const Version*> currentVersion;
+		std::atomic<uint64_t> currentSequenceNumber;
+		
+		// serializes the writers and the registration of readers
+		mutable std::mutex mutex;
+		std::deque<std::unique_ptr<Version>> versions;
+		std::vector<typename Reader::Slot*> readerSlots;
 	};
 };
 
+// the library only contains float and double splines of 2D, 3D and 6D points, header-only mode allows other instantiations and inlining of the
+// evaluation functions at call sites
+#ifdef SIMPLINE_HEADER_ONLY
+#include "ThreadPoolImpl.h"
+#include "StatisticsImpl.h"
+#include "ParametrizedSplineImpl.h"
+#include "ConstantSpeedSplineImpl.h"
+#include "SplineBatchImpl.h"
+#include "BakedSplineImpl.h"
+#include "SplineBuilderImpl.h"
+#include "SplineHandleImpl.h"
+#endif
+
 #endif
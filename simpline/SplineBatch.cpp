@@ -0,0 +1,13 @@
+#include "SplineBatchImpl.h"
+
+template class simpline<float, 2>::SplineBatch;
+
+template class simpline<float, 3>::SplineBatch;
+
+template class simpline<float, 6>::SplineBatch;
+
+template class simpline<double, 2>::SplineBatch;
+
+template class simpline<double, 3>::SplineBatch;
+
+template class simpline<double, 6>::SplineBatch;
@@ -0,0 +1,488 @@
+#ifndef SIMPLINE_SPLINE_BATCH_IMPL_H
+#define SIMPLINE_SPLINE_BATCH_IMPL_H
+
+#include "Simpline.h"
+#include "Constants.h"
+#include "ParametrizedSplineImpl.h"
+#include "Statistics.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace simplineInternal
+{
+// range of an array shared by the splines of a batch, searched like the array of a single spline
+template<typename T>
+struct ArrayView
+{
+	const T* first;
+	size_t count;
+	
+	size_t size() const
+	{
+		return count;
+	}
+	
+	const T* begin() const
+	{
+		return first;
+	}
+	
+	const T* end() const
+	{
+		return first + count;
+	}
+	
+	const T& operator[](const size_t& index) const
+	{
+		return first[index];
+	}
+};
+
+// norms of the gradients of the segments of the lanes at their local parameter values, column 3 * axis + power holding the coefficients of the
+// gradients in increasing powers
+template<typename GradientCoefficients, typename Lanes>
+Lanes computeGradientNormLanes(const GradientCoefficients& gradientCoefficients, const Lanes& localParameterValues)
+{
+	Lanes squaredNorms = Lanes::Zero();
+	for(int i = 0; i < GradientCoefficients::ColsAtCompileTime / 3; i++)
+	{
+		squaredNorms += (gradientCoefficients.col(3 * i) +
+						 localParameterValues * (gradientCoefficients.col(3 * i + 1) + localParameterValues * gradientCoefficients.col(3 * i + 2))).square();
+	}
+	return squaredNorms.sqrt();
+}
+
+// same steps as invertSegmentLength for each lane of the mask, on parameter values local to the segments of the lanes, lengths and gradient norms
+// being computed for all lanes together so that they are vectorized across lanes, lanes leave the iterations as soon as their own root is found
+template<size_t N, typename GradientCoefficients, typename Mask, typename Lanes>
+void invertSegmentLengthLanes(const std::array<double, N>& abcissa, const std::array<double, N>& weights, const GradientCoefficients& gradientCoefficients,
+							  const Mask& mask, const Lanes& wantedLengths, const Lanes& tolerances, Lanes& lowerBounds, Lanes& upperBounds,
+							  Lanes& localParameterValues, Lanes& integratedParameterValues, Lanes& lengthErrors)
+{
+	typedef typename Lanes::Scalar T;
+	bool solving[Lanes::RowsAtCompileTime];
+	size_t solvingCount = 0;
+	for(int i = 0; i < Lanes::RowsAtCompileTime; i++)
+	{
+		solving[i] = mask(i);
+		solvingCount += solving[i];
+	}
+	SIMPLINE_COUNT(rootFindingCount, solvingCount);
+	
+	for(size_t i = 0; i < maximumRootFindingIterations && solvingCount > 0; i++)
+	{
+		SIMPLINE_COUNT(rootFindingIterationCount, solvingCount);
+		SIMPLINE_COUNT(quadratureCount, solvingCount);
+		SIMPLINE_COUNT(gradientEvaluationCount, N * solvingCount);
+		Lanes integrals = Lanes::Zero();
+		for(size_t j = 0; j < N; j++)
+		{
+			integrals += T(weights[j]) * computeGradientNormLanes(gradientCoefficients, Lanes(T((abcissa[j] + 1.0) / 2.0) * localParameterValues));
+		}
+		const Lanes errors = (localParameterValues / 2) * integrals - wantedLengths;
+		const Lanes gradientNorms = computeGradientNormLanes(gradientCoefficients, localParameterValues);
+		
+		for(int j = 0; j < Lanes::RowsAtCompileTime; j++)
+		{
+			if(!solving[j])
+			{
+				continue;
+			}
+			
+			T& parameterValue = localParameterValues(j);
+			const T& lengthError = errors(j);
+			integratedParameterValues(j) = parameterValue;
+			lengthErrors(j) = lengthError;
+			if(lengthError == 0)
+			{
+				solving[j] = false;
+				solvingCount--;
+				continue;
+			}
+			
+			if(lengthError < 0)
+			{
+				lowerBounds(j) = parameterValue;
+			}
+			else
+			{
+				upperBounds(j) = parameterValue;
+			}
+			
+			T nextParameterValue = parameterValue - lengthError / gradientNorms(j);
+			if(std::abs(nextParameterValue - parameterValue) <= tolerances(j))
+			{
+				parameterValue = std::min(std::max(nextParameterValue, lowerBounds(j)), upperBounds(j));
+				solving[j] = false;
+				solvingCount--;
+				continue;
+			}
+			
+			if(!(nextParameterValue > lowerBounds(j) && nextParameterValue < upperBounds(j)))
+			{
+				nextParameterValue = (lowerBounds(j) + upperBounds(j)) / 2;
+			}
+			
+			const T step = std::abs(nextParameterValue - parameterValue);
+			parameterValue = nextParameterValue;
+			if(step <= tolerances(j) || upperBounds(j) - lowerBounds(j) <= tolerances(j))
+			{
+				solving[j] = false;
+				solvingCount--;
+			}
+		}
+	}
+}
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::SplineBatch::SplineBatch():
+		removedPointCount(0)
+{
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::SplineBatch::add(const ConstantSpeedSpline& spline)
+{
+	const ParametrizedSpline& parametrizedSpline = spline.parametrizedSpline;
+	if(parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot add empty constant-speed spline to batch. Use non-default constructor to provide points.");
+	}
+	
+	size_t identifier = splineIndices.size();
+	if(freeIdentifiers.empty())
+	{
+		splineIndices.push_back(identifiers.size());
+	}
+	else
+	{
+		identifier = freeIdentifiers.back();
+		freeIdentifiers.pop_back();
+		splineIndices[identifier] = identifiers.size();
+	}
+	
+	identifiers.push_back(identifier);
+	if(identifiers.size() > size_t(cursorSegments.rows()))
+	{
+		const Eigen::Index rowCount = cursorSegments.rows();
+		cursorSegments.conservativeResize(std::max<Eigen::Index>(simplineInternal::evaluationBlockSize, 2 * rowCount), Eigen::NoChange);
+		cursorSegments.bottomRows(cursorSegments.rows() - rowCount).setZero();
+	}
+	firstPointIndices.push_back(parameterValues.size());
+	pointCounts.push_back(parametrizedSpline.parameterValues.size());
+	speeds.push_back(spline.speed);
+	durations.push_back(spline.duration);
+	tolerances.push_back(spline.tolerance);
+	quadratures.push_back(parametrizedSpline.quadrature);
+	cursors.push_back(SplineCursor());
+	
+	parameterValues.insert(parameterValues.end(), parametrizedSpline.parameterValues.begin(), parametrizedSpline.parameterValues.end());
+	segments.insert(segments.end(), parametrizedSpline.segments.begin(), parametrizedSpline.segments.end());
+	cumulativeLengths.insert(cumulativeLengths.end(), parametrizedSpline.cumulativeLengths.begin(), parametrizedSpline.cumulativeLengths.end());
+	
+	return identifier;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineBatch::remove(const size_t& identifier)
+{
+	if(identifier >= splineIndices.size() || splineIndices[identifier] == std::numeric_limits<size_t>::max())
+	{
+		throw std::runtime_error("Removal of spline " + std::to_string(identifier) + " requested. This spline is not in the batch.");
+	}
+	
+	const size_t splineIndex = splineIndices[identifier];
+	removedPointCount += pointCounts[splineIndex];
+	
+	// the last spline takes the place of the removed one
+	const auto moveLastSpline = [&splineIndex](auto& items)
+	{
+		items[splineIndex] = items.back();
+		items.pop_back();
+	};
+	moveLastSpline(identifiers);
+	moveLastSpline(firstPointIndices);
+	moveLastSpline(pointCounts);
+	moveLastSpline(speeds);
+	moveLastSpline(durations);
+	moveLastSpline(tolerances);
+	moveLastSpline(quadratures);
+	moveLastSpline(cursors);
+	cursorSegments.row(splineIndex) = cursorSegments.row(identifiers.size());
+	cursorSegments.row(identifiers.size()).setZero();
+	if(splineIndex < identifiers.size())
+	{
+		splineIndices[identifiers[splineIndex]] = splineIndex;
+	}
+	splineIndices[identifier] = std::numeric_limits<size_t>::max();
+	freeIdentifiers.push_back(identifier);
+	
+	if(removedPointCount > parameterValues.size() - removedPointCount)
+	{
+		compact();
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineBatch::compact()
+{
+	std::vector<T> compactParameterValues;
+	simplineInternal::AlignedVector<SegmentCoefficients> compactSegments;
+	std::vector<T> compactCumulativeLengths;
+	compactParameterValues.reserve(parameterValues.size() - removedPointCount);
+	compactSegments.reserve(parameterValues.size() - removedPointCount);
+	compactCumulativeLengths.reserve(parameterValues.size() - removedPointCount);
+	for(size_t i = 0; i < identifiers.size(); i++)
+	{
+		const size_t firstPointIndex = firstPointIndices[i];
+		const size_t lastPointIndex = firstPointIndex + pointCounts[i];
+		firstPointIndices[i] = compactParameterValues.size();
+		compactParameterValues.insert(compactParameterValues.end(), parameterValues.begin() + firstPointIndex, parameterValues.begin() + lastPointIndex);
+		compactSegments.insert(compactSegments.end(), segments.begin() + firstPointIndex, segments.begin() + lastPointIndex);
+		compactCumulativeLengths.insert(compactCumulativeLengths.end(), cumulativeLengths.begin() + firstPointIndex,
+										cumulativeLengths.begin() + lastPointIndex);
+	}
+	
+	parameterValues.swap(compactParameterValues);
+	segments.swap(compactSegments);
+	cumulativeLengths.swap(compactCumulativeLengths);
+	removedPointCount = 0;
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::SplineBatch::size() const
+{
+	return identifiers.size();
+}
+
+template<typename T, int Dim>
+const std::vector<size_t>& simpline<T, Dim>::SplineBatch::getIdentifiers() const
+{
+	return identifiers;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineBatch::evaluate(const T& time, T* values, T* gradients)
+{
+	SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "evaluate", nullptr);
+	
+	if(time < 0.0)
+	{
+		throw std::runtime_error("Batch evaluation requested at time=" + std::to_string(time) + ". Time must be above 0.0.");
+	}
+	
+	for(size_t i = 0; i < identifiers.size(); i += simplineInternal::evaluationBlockSize)
+	{
+		evaluateSplines(i, std::min(i + simplineInternal::evaluationBlockSize, identifiers.size()), time, values, gradients);
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineBatch::evaluate(const T& time, T* values, T* gradients, ThreadPool& threadPool)
+{
+	if(time < 0.0)
+	{
+		throw std::runtime_error("Batch evaluation requested at time=" + std::to_string(time) + ". Time must be above 0.0.");
+	}
+	
+	// each spline only updates its own cursor, so that results do not depend on the threads, chunks are made of whole blocks of lanes
+	threadPool.parallelFor(identifiers.size(), simplineInternal::parallelChunkSize, [&](const size_t& first, const size_t& last)
+	{
+		SIMPLINE_STATISTICS_SCOPE(statisticsRecorder, "evaluate", nullptr);
+		
+		for(size_t i = first; i < last; i += simplineInternal::evaluationBlockSize)
+		{
+			evaluateSplines(i, std::min(i + simplineInternal::evaluationBlockSize, last), time, values, gradients);
+		}
+	});
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineBatch::evaluateSplines(const size_t& first, const size_t& last, const T& time, T* values, T* gradients)
+{
+	typedef Eigen::Array<T, simplineInternal::evaluationBlockSize, 1> Lanes;
+	typedef Eigen::Array<bool, simplineInternal::evaluationBlockSize, 1> Mask;
+	
+	// same steps as the evaluation of a single constant-speed spline, the segments are searched and their ends handled one spline at a time, while
+	// the Newton iterations and the evaluations are done in lanes, lanes past the last spline have zero coefficients and are masked out
+	Lanes lengths = Lanes::Zero();
+	Lanes wantedLengths = Lanes::Zero();
+	Lanes segmentLengths = Lanes::Ones();
+	Lanes lowerBounds = Lanes::Zero();
+	Lanes upperBounds = Lanes::Zero();
+	Lanes localParameterValues = Lanes::Zero();
+	Lanes anchorLengthSteps = Lanes::Zero();
+	Lanes laneTolerances = Lanes::Zero();
+	Lanes laneSpeeds = Lanes::Zero();
+	Mask solving = Mask::Constant(false);
+	Mask anchored = Mask::Constant(false);
+	Eigen::Array<int, simplineInternal::evaluationBlockSize, 1> rules = Eigen::Array<int, simplineInternal::evaluationBlockSize, 1>::Zero();
+	const size_t laneCount = last - first;
+	for(size_t i = 0; i < laneCount; i++)
+	{
+		const size_t splineIndex = first + i;
+		const size_t& firstPointIndex = firstPointIndices[splineIndex];
+		const simplineInternal::ArrayView<T> splineCumulativeLengths = {cumulativeLengths.data() + firstPointIndex, pointCounts[splineIndex]};
+		SplineCursor& cursor = cursors[splineIndex];
+		
+		const T length = std::min(std::min(time, durations[splineIndex]) * speeds[splineIndex], splineCumulativeLengths[splineCumulativeLengths.size() - 1]);
+		const size_t segmentIndex = simplineInternal::findIntervalIndex(splineCumulativeLengths, length, cursor.segmentIndex);
+		if(segmentIndex != cursor.segmentIndex)
+		{
+			loadSegment(splineIndex, segmentIndex);
+			cursor.segmentIndex = segmentIndex;
+		}
+		
+		const size_t pointIndex = firstPointIndex + segmentIndex;
+		lengths(i) = length;
+		wantedLengths(i) = length - cumulativeLengths[pointIndex];
+		segmentLengths(i) = cumulativeLengths[pointIndex + 1] - cumulativeLengths[pointIndex];
+		upperBounds(i) = parameterValues[pointIndex + 1] - parameterValues[pointIndex];
+		laneSpeeds(i) = speeds[splineIndex];
+		if(wantedLengths(i) <= 0)
+		{
+			continue;
+		}
+		if(wantedLengths(i) >= segmentLengths(i))
+		{
+			localParameterValues(i) = upperBounds(i);
+			continue;
+		}
+		
+		// the bisections of the adaptive rule differ from a segment to another, such segments are inverted alone
+		const Quadrature& quadrature = quadratures[splineIndex];
+		if(quadrature.rule == Quadrature::ADAPTIVE_GAUSS_KRONROD_15)
+		{
+			localParameterValues(i) = simplineInternal::invertSegmentLength(segments.data() + firstPointIndex, parameterValues.data() + firstPointIndex,
+																			splineCumulativeLengths.first, segmentIndex, quadrature, length,
+																			tolerances[splineIndex], cursor.anchorSegmentIndex, cursor.anchorParameterValue,
+																			cursor.anchorLength) - parameterValues[pointIndex];
+			continue;
+		}
+		
+		solving(i) = true;
+		rules(i) = quadrature.rule;
+		laneTolerances(i) = tolerances[splineIndex];
+		if(cursor.anchorSegmentIndex == segmentIndex && cursor.anchorLength <= length)
+		{
+			anchored(i) = true;
+			lowerBounds(i) = cursor.anchorParameterValue - parameterValues[pointIndex];
+			anchorLengthSteps(i) = length - cursor.anchorLength;
+		}
+	}
+	
+	const auto coefficients = cursorSegments.template middleRows<simplineInternal::evaluationBlockSize>(first);
+	Eigen::Array<T, simplineInternal::evaluationBlockSize, 3 * Dim> gradientCoefficients;
+	for(int i = 0; i < Dim; i++)
+	{
+		gradientCoefficients.col(3 * i) = coefficients.col(4 * i + 1);
+		gradientCoefficients.col(3 * i + 1) = 2 * coefficients.col(4 * i + 2);
+		gradientCoefficients.col(3 * i + 2) = 3 * coefficients.col(4 * i + 3);
+	}
+	
+	// initial guesses of single splines, with the second order Taylor expansion from the anchor when it is in the same segment
+	Lanes squaredGradientNorms = Lanes::Zero();
+	Lanes gradientDots = Lanes::Zero();
+	for(int i = 0; i < Dim; i++)
+	{
+		const Lanes gradient = gradientCoefficients.col(3 * i) +
+							   lowerBounds * (gradientCoefficients.col(3 * i + 1) + lowerBounds * gradientCoefficients.col(3 * i + 2));
+		squaredGradientNorms += gradient.square();
+		gradientDots += gradient * (gradientCoefficients.col(3 * i + 1) + 2 * lowerBounds * gradientCoefficients.col(3 * i + 2));
+	}
+	const Lanes taylorGuesses = lowerBounds + anchorLengthSteps / squaredGradientNorms.sqrt() -
+								(anchorLengthSteps.square() * gradientDots) / (2 * squaredGradientNorms.square());
+	const Lanes anchoredGuesses = (taylorGuesses >= lowerBounds && taylorGuesses < upperBounds).select(taylorGuesses, (lowerBounds + upperBounds) / 2);
+	localParameterValues = solving.select(anchored.select(anchoredGuesses, (wantedLengths / segmentLengths) * upperBounds), localParameterValues);
+	
+	Lanes integratedParameterValues = localParameterValues;
+	Lanes lengthErrors = Lanes::Zero();
+	simplineInternal::invertSegmentLengthLanes(simplineInternal::gaussianQuadratureAbcissa5, simplineInternal::gaussianQuadratureWeights5,
+											   gradientCoefficients, solving && rules == int(Quadrature::GAUSS_LEGENDRE_5), wantedLengths, laneTolerances,
+											   lowerBounds, upperBounds, localParameterValues, integratedParameterValues, lengthErrors);
+	simplineInternal::invertSegmentLengthLanes(simplineInternal::gaussianQuadratureAbcissa7, simplineInternal::gaussianQuadratureWeights7,
+											   gradientCoefficients, solving && rules == int(Quadrature::GAUSS_LEGENDRE_7), wantedLengths, laneTolerances,
+											   lowerBounds, upperBounds, localParameterValues, integratedParameterValues, lengthErrors);
+	simplineInternal::invertSegmentLengthLanes(simplineInternal::gaussianQuadratureAbcissa, simplineInternal::gaussianQuadratureWeights,
+											   gradientCoefficients, solving && rules == int(Quadrature::GAUSS_LEGENDRE_25), wantedLengths, laneTolerances,
+											   lowerBounds, upperBounds, localParameterValues, integratedParameterValues, lengthErrors);
+	for(size_t i = 0; i < laneCount; i++)
+	{
+		if(solving(i))
+		{
+			SplineCursor& cursor = cursors[first + i];
+			cursor.anchorSegmentIndex = cursor.segmentIndex;
+			cursor.anchorParameterValue = parameterValues[firstPointIndices[first + i] + cursor.segmentIndex] + integratedParameterValues(i);
+			cursor.anchorLength = lengths(i) + lengthErrors(i);
+		}
+	}
+	
+	if(values)
+	{
+		for(int i = 0; i < Dim; i++)
+		{
+			const Lanes axisValues = coefficients.col(4 * i) + localParameterValues * (coefficients.col(4 * i + 1) + localParameterValues *
+									 (coefficients.col(4 * i + 2) + localParameterValues * coefficients.col(4 * i + 3)));
+			for(size_t j = 0; j < laneCount; j++)
+			{
+				values[Dim * (first + j) + i] = axisValues(j);
+			}
+		}
+	}
+	if(gradients)
+	{
+		Eigen::Array<T, simplineInternal::evaluationBlockSize, Dim> laneGradients;
+		for(int i = 0; i < Dim; i++)
+		{
+			laneGradients.col(i) = gradientCoefficients.col(3 * i) +
+								   localParameterValues * (gradientCoefficients.col(3 * i + 1) + localParameterValues * gradientCoefficients.col(3 * i + 2));
+		}
+		// unit tangents times the speed, zero gradients are left to zero as by normalized()
+		const Lanes gradientNorms = laneGradients.square().rowwise().sum().sqrt();
+		const Lanes scales = (gradientNorms > 0).select(laneSpeeds / gradientNorms, T(0));
+		for(size_t j = 0; j < laneCount; j++)
+		{
+			for(int i = 0; i < Dim; i++)
+			{
+				gradients[Dim * (first + j) + i] = laneGradients(j, i) * scales(j);
+			}
+		}
+	}
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineBatch::loadSegment(const size_t& splineIndex, const size_t& segmentIndex)
+{
+	const SegmentCoefficients& coefficients = segments[firstPointIndices[splineIndex] + segmentIndex];
+	for(int i = 0; i < Dim; i++)
+	{
+		for(int j = 0; j < 4; j++)
+		{
+			cursorSegments(splineIndex, 4 * i + j) = coefficients(i, j);
+		}
+	}
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Statistics simpline<T, Dim>::SplineBatch::getStatistics() const
+{
+#ifdef SIMPLINE_ENABLE_STATISTICS
+	return statisticsRecorder.getStatistics();
+#else
+	return Statistics();
+#endif
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineBatch::setTraceCallback(const TraceCallback& traceCallback)
+{
+#ifdef SIMPLINE_ENABLE_STATISTICS
+	statisticsRecorder.setTraceCallback(traceCallback);
+#else
+	(void)traceCallback;
+#endif
+}
+
+#endif
@@ -0,0 +1,13 @@
+#include "SplineBuilderImpl.h"
+
+template class simpline<float, 2>::SplineBuilder;
+
+template class simpline<float, 3>::SplineBuilder;
+
+template class simpline<float, 6>::SplineBuilder;
+
+template class simpline<double, 2>::SplineBuilder;
+
+template class simpline<double, 3>::SplineBuilder;
+
+template class simpline<double, 6>::SplineBuilder;
@@ -0,0 +1,100 @@
+#ifndef SIMPLINE_SPLINE_BUILDER_IMPL_H
+#define SIMPLINE_SPLINE_BUILDER_IMPL_H
+
+#include "Simpline.h"
+#include "ConstantSpeedSplineImpl.h"
+
+template<typename T, int Dim>
+simpline<T, Dim>::SplineBuilder::SplineBuilder():
+		stopping(false), worker(&SplineBuilder::work, this)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::SplineBuilder::~SplineBuilder()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	condition.notify_all();
+	worker.join();
+}
+
+template<typename T, int Dim>
+std::future<typename simpline<T, Dim>::ConstantSpeedSpline> simpline<T, Dim>::SplineBuilder::build(const std::vector<simpline<T, Dim>::Vector>& points,
+																									 const T& speed)
+{
+	return enqueue(std::packaged_task<ConstantSpeedSpline()>([points, speed]()
+	{
+		return ConstantSpeedSpline(points, speed);
+	}));
+}
+
+template<typename T, int Dim>
+std::future<typename simpline<T, Dim>::ConstantSpeedSpline> simpline<T, Dim>::SplineBuilder::build(const std::vector<simpline<T, Dim>::Vector>& points,
+																									 const T& speed, const T& tolerance)
+{
+	return enqueue(std::packaged_task<ConstantSpeedSpline()>([points, speed, tolerance]()
+	{
+		return ConstantSpeedSpline(points, speed, tolerance);
+	}));
+}
+
+template<typename T, int Dim>
+std::future<typename simpline<T, Dim>::ConstantSpeedSpline> simpline<T, Dim>::SplineBuilder::build(const std::vector<simpline<T, Dim>::Vector>& points,
+																									 const T& speed, const T& tolerance,
+																									 const Quadrature& quadrature)
+{
+	return enqueue(std::packaged_task<ConstantSpeedSpline()>([points, speed, tolerance, quadrature]()
+	{
+		return ConstantSpeedSpline(points, speed, tolerance, quadrature);
+	}));
+}
+
+template<typename T, int Dim>
+std::future<typename simpline<T, Dim>::ConstantSpeedSpline> simpline<T, Dim>::SplineBuilder::build(const std::vector<simpline<T, Dim>::Vector>& points,
+																									 const T& speed, const T& tolerance,
+																									 const Quadrature& quadrature, ThreadPool& threadPool)
+{
+	return enqueue(std::packaged_task<ConstantSpeedSpline()>([points, speed, tolerance, quadrature, &threadPool]()
+	{
+		return ConstantSpeedSpline(points, speed, tolerance, quadrature, threadPool);
+	}));
+}
+
+template<typename T, int Dim>
+std::future<typename simpline<T, Dim>::ConstantSpeedSpline> simpline<T, Dim>::SplineBuilder::enqueue(std::packaged_task<ConstantSpeedSpline()>&& task)
+{
+	std::future<ConstantSpeedSpline> future = task.get_future();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	condition.notify_one();
+	return future;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineBuilder::work()
+{
+	while(true)
+	{
+		std::packaged_task<ConstantSpeedSpline()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if(tasks.empty())
+			{
+				return;
+			}
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		
+		// exceptions are stored in the future
+		task();
+	}
+}
+
+#endif
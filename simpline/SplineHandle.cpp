@@ -0,0 +1,13 @@
+#include "SplineHandleImpl.h"
+
+template class simpline<float, 2>::SplineHandle;
+
+template class simpline<float, 3>::SplineHandle;
+
+template class simpline<float, 6>::SplineHandle;
+
+template class simpline<double, 2>::SplineHandle;
+
+template class simpline<double, 3>::SplineHandle;
+
+template class simpline<double, 6>::SplineHandle;
@@ -0,0 +1,217 @@
+#ifndef SIMPLINE_SPLINE_HANDLE_IMPL_H
+#define SIMPLINE_SPLINE_HANDLE_IMPL_H
+
+#include "Simpline.h"
+#include "ConstantSpeedSplineImpl.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+template<typename T, int Dim>
+simpline<T, Dim>::SplineHandle::Reader::Reader(SplineHandle& handle):
+		handle(&handle), slot(new Slot()), sequenceNumber(0)
+{
+	slot->pinnedSequenceNumber.store(std::numeric_limits<uint64_t>::max());
+	slot->time.store(std::numeric_limits<T>::lowest());
+	
+	std::lock_guard<std::mutex> lock(handle.mutex);
+	handle.readerSlots.push_back(slot.get());
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::SplineHandle::Reader::~Reader()
+{
+	std::lock_guard<std::mutex> lock(handle->mutex);
+	handle->readerSlots.erase(std::find(handle->readerSlots.begin(), handle->readerSlots.end(), slot.get()));
+}
+
+template<typename T, int Dim>
+template<typename Evaluation>
+typename simpline<T, Dim>::Status simpline<T, Dim>::SplineHandle::Reader::read(const T& time, const Evaluation& evaluation) noexcept
+{
+	// the pin is a lower bound on the version loaded after it, the writer either sees the pin and keeps that version or published before the pin
+	// and the reader loads the newer version
+	const uint64_t currentSequenceNumber = handle->currentSequenceNumber.load();
+	if(currentSequenceNumber == 0)
+	{
+		return EMPTY_SPLINE;
+	}
+	
+	if(std::isnan(time))
+	{
+		return INVALID_ARGUMENT;
+	}
+	
+	slot->time.store(time, std::memory_order_relaxed);
+	slot->pinnedSequenceNumber.store(currentSequenceNumber);
+	const Version* version = handle->currentVersion.load();
+	if(version->sequenceNumber != sequenceNumber)
+	{
+		cursor = SplineCursor();
+		sequenceNumber = version->sequenceNumber;
+	}
+	const Status status = evaluation(version->spline, time - version->timeOffset);
+	slot->pinnedSequenceNumber.store(std::numeric_limits<uint64_t>::max(), std::memory_order_release);
+	return status;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::SplineHandle::Reader::tryGetValue(const T& time, simpline<T, Dim>::Vector& value) noexcept
+{
+	return read(time, [this, &value](const ConstantSpeedSpline& spline, const T& splineTime)
+	{
+		return spline.tryGetValue(splineTime, value, cursor);
+	});
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::SplineHandle::Reader::tryGetGradient(const T& time, simpline<T, Dim>::Vector& gradient) noexcept
+{
+	return read(time, [this, &gradient](const ConstantSpeedSpline& spline, const T& splineTime)
+	{
+		return spline.tryGetGradient(splineTime, gradient, cursor);
+	});
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Status simpline<T, Dim>::SplineHandle::Reader::tryEvaluateState(const T& time, State& state, const bool& withFrenetFrame) noexcept
+{
+	return read(time, [this, &state, &withFrenetFrame](const ConstantSpeedSpline& spline, const T& splineTime)
+	{
+		return spline.tryEvaluateState(splineTime, state, cursor, withFrenetFrame);
+	});
+}
+
+template<typename T, int Dim>
+uint64_t simpline<T, Dim>::SplineHandle::Reader::getSequenceNumber() const noexcept
+{
+	return sequenceNumber;
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::SplineHandle::SplineHandle():
+		currentVersion(nullptr), currentSequenceNumber(0)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::SplineHandle::~SplineHandle()
+{
+}
+
+template<typename T, int Dim>
+uint64_t simpline<T, Dim>::SplineHandle::publish(const ConstantSpeedSpline& spline)
+{
+	if(spline.parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot publish empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	std::lock_guard<std::mutex> lock(mutex);
+	const T time = getLatestReaderTime();
+	if(versions.empty())
+	{
+		return publishVersion(spline, time);
+	}
+	
+	const Version& previousVersion = *versions.back();
+	const T previousTime = std::min(std::max(time - previousVersion.timeOffset, T(0)), previousVersion.spline.getDuration());
+	const simpline<T, Dim>::Vector position = previousVersion.spline.getValue(previousTime);
+	
+	// a new version that loops back or crosses itself passes near the readers more than once, the pass near the arc length they reached on the
+	// current version is kept unless the readers are out of that window, such as for new versions starting from the position of the readers
+	Projection projection;
+	if(!spline.projectNearLength(position, previousTime * previousVersion.spline.speed, projection))
+	{
+		projection = spline.project(position);
+	}
+	return publishVersion(spline, time - projection.time);
+}
+
+template<typename T, int Dim>
+uint64_t simpline<T, Dim>::SplineHandle::publish(const ConstantSpeedSpline& spline, const T& startTime)
+{
+	if(spline.parametrizedSpline.parameterValues.size() == 0)
+	{
+		throw std::runtime_error("Cannot publish empty constant-speed spline. Use non-default constructor to provide points.");
+	}
+	
+	if(std::isnan(startTime))
+	{
+		throw std::runtime_error("Start time cannot be NaN!");
+	}
+	
+	std::lock_guard<std::mutex> lock(mutex);
+	return publishVersion(spline, startTime);
+}
+
+template<typename T, int Dim>
+uint64_t simpline<T, Dim>::SplineHandle::publishVersion(const ConstantSpeedSpline& spline, const T& timeOffset)
+{
+	versions.emplace_back(new Version{spline, timeOffset, currentSequenceNumber.load(std::memory_order_relaxed) + 1});
+	const Version* version = versions.back().get();
+	currentVersion.store(version);
+	currentSequenceNumber.store(version->sequenceNumber);
+	freeVersions();
+	return version->sequenceNumber;
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::SplineHandle::getLatestReaderTime() const
+{
+	T latestTime = std::numeric_limits<T>::lowest();
+	for(const typename Reader::Slot* readerSlot: readerSlots)
+	{
+		latestTime = std::max(latestTime, readerSlot->time.load(std::memory_order_relaxed));
+	}
+	
+	// without evaluations, the new version continues from the start of the current one
+	if(latestTime == std::numeric_limits<T>::lowest())
+	{
+		return versions.empty() ? T(0) : versions.back()->timeOffset;
+	}
+	return latestTime;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::SplineHandle::freeVersions()
+{
+	uint64_t oldestPinnedSequenceNumber = versions.back()->sequenceNumber;
+	for(const typename Reader::Slot* readerSlot: readerSlots)
+	{
+		oldestPinnedSequenceNumber = std::min(oldestPinnedSequenceNumber, readerSlot->pinnedSequenceNumber.load());
+	}
+	
+	while(versions.front()->sequenceNumber < oldestPinnedSequenceNumber)
+	{
+		versions.pop_front();
+	}
+}
+
+template<typename T, int Dim>
+uint64_t simpline<T, Dim>::SplineHandle::getSequenceNumber() const
+{
+	return currentSequenceNumber.load();
+}
+
+template<typename T, int Dim>
+T simpline<T, Dim>::SplineHandle::getStartTime() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if(versions.empty())
+	{
+		throw std::runtime_error("Cannot get start time of empty spline handle. Publish a spline first.");
+	}
+	
+	return versions.back()->timeOffset;
+}
+
+template<typename T, int Dim>
+size_t simpline<T, Dim>::SplineHandle::getVersionCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return versions.size();
+}
+
+#endif
@@ -0,0 +1,37 @@
+#include "StatisticsImpl.h"
+
+template struct simpline<float, 2>::Statistics;
+
+template class simpline<float, 2>::StatisticsRecorder;
+
+template class simpline<float, 2>::StatisticsScope;
+
+template struct simpline<float, 3>::Statistics;
+
+template class simpline<float, 3>::StatisticsRecorder;
+
+template class simpline<float, 3>::StatisticsScope;
+
+template struct simpline<float, 6>::Statistics;
+
+template class simpline<float, 6>::StatisticsRecorder;
+
+template class simpline<float, 6>::StatisticsScope;
+
+template struct simpline<double, 2>::Statistics;
+
+template class simpline<double, 2>::StatisticsRecorder;
+
+template class simpline<double, 2>::StatisticsScope;
+
+template struct simpline<double, 3>::Statistics;
+
+template class simpline<double, 3>::StatisticsRecorder;
+
+template class simpline<double, 3>::StatisticsScope;
+
+template struct simpline<double, 6>::Statistics;
+
+template class simpline<double, 6>::StatisticsRecorder;
+
+template class simpline<double, 6>::StatisticsScope;
@@ -0,0 +1,46 @@
+#ifndef SIMPLINE_STATISTICS_H
+#define SIMPLINE_STATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// counting is compiled out unless SIMPLINE_ENABLE_STATISTICS is defined, the library and its users must be compiled with the same definition
+#ifdef SIMPLINE_ENABLE_STATISTICS
+#define SIMPLINE_COUNT(counter, amount) (simplineInternal::threadCounters.counter += (amount))
+#define SIMPLINE_STATISTICS_SCOPE(recorder, operation, time) const StatisticsScope statisticsScope(recorder, operation, time)
+#else
+#define SIMPLINE_COUNT(counter, amount) ((void)0)
+#define SIMPLINE_STATISTICS_SCOPE(recorder, operation, time) ((void)0)
+#endif
+
+namespace simplineInternal
+{
+struct EvaluationCounters
+{
+	uint64_t segmentSearchCount;
+	uint64_t scannedSegmentCount;
+	uint64_t rootFindingCount;
+	uint64_t rootFindingIterationCount;
+	uint64_t quadratureCount;
+	uint64_t gradientEvaluationCount;
+};
+
+// work counted by the calling thread, statistics scopes attribute its increase to their spline
+inline thread_local EvaluationCounters threadCounters = {};
+
+inline thread_local size_t statisticsScopeDepth = 0;
+
+// upper bound of the number of values compared by a binary search
+inline uint64_t countBinarySearchComparisons(size_t valueCount)
+{
+	uint64_t comparisonCount = 0;
+	while(valueCount > 0)
+	{
+		comparisonCount++;
+		valueCount /= 2;
+	}
+	return comparisonCount;
+}
+}
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef SIMPLINE_STATISTICS_IMPL_H
+#define SIMPLINE_STATISTICS_IMPL_H
+
+#include "Simpline.h"
+#include "Statistics.h"
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Statistics& simpline<T, Dim>::Statistics::operator+=(const Statistics& other)
+{
+	evaluationCount += other.evaluationCount;
+	segmentSearchCount += other.segmentSearchCount;
+	scannedSegmentCount += other.scannedSegmentCount;
+	rootFindingCount += other.rootFindingCount;
+	rootFindingIterationCount += other.rootFindingIterationCount;
+	quadratureCount += other.quadratureCount;
+	gradientEvaluationCount += other.gradientEvaluationCount;
+	sortingTime += other.sortingTime;
+	factorizationTime += other.factorizationTime;
+	solvingTime += other.solvingTime;
+	lengthIntegrationTime += other.lengthIntegrationTime;
+	parametrizationTime += other.parametrizationTime;
+	return *this;
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::StatisticsRecorder::StatisticsRecorder():
+		evaluationCount(0), segmentSearchCount(0), scannedSegmentCount(0), rootFindingCount(0), rootFindingIterationCount(0), quadratureCount(0),
+		gradientEvaluationCount(0), sortingTime(0), factorizationTime(0), solvingTime(0), lengthIntegrationTime(0), parametrizationTime(0)
+{
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::StatisticsRecorder::StatisticsRecorder(const StatisticsRecorder& other):
+		StatisticsRecorder()
+{
+	*this = other;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::StatisticsRecorder& simpline<T, Dim>::StatisticsRecorder::operator=(const StatisticsRecorder& other)
+{
+	if(this != &other)
+	{
+		const Statistics statistics = other.getStatistics();
+		evaluationCount = statistics.evaluationCount;
+		segmentSearchCount = statistics.segmentSearchCount;
+		scannedSegmentCount = statistics.scannedSegmentCount;
+		rootFindingCount = statistics.rootFindingCount;
+		rootFindingIterationCount = statistics.rootFindingIterationCount;
+		quadratureCount = statistics.quadratureCount;
+		gradientEvaluationCount = statistics.gradientEvaluationCount;
+		sortingTime = statistics.sortingTime;
+		factorizationTime = statistics.factorizationTime;
+		solvingTime = statistics.solvingTime;
+		lengthIntegrationTime = statistics.lengthIntegrationTime;
+		parametrizationTime = statistics.parametrizationTime;
+		traceCallback = other.traceCallback;
+	}
+	return *this;
+}
+
+template<typename T, int Dim>
+typename simpline<T, Dim>::Statistics simpline<T, Dim>::StatisticsRecorder::getStatistics() const
+{
+	Statistics statistics;
+	statistics.evaluationCount = evaluationCount.load(std::memory_order_relaxed);
+	statistics.segmentSearchCount = segmentSearchCount.load(std::memory_order_relaxed);
+	statistics.scannedSegmentCount = scannedSegmentCount.load(std::memory_order_relaxed);
+	statistics.rootFindingCount = rootFindingCount.load(std::memory_order_relaxed);
+	statistics.rootFindingIterationCount = rootFindingIterationCount.load(std::memory_order_relaxed);
+	statistics.quadratureCount = quadratureCount.load(std::memory_order_relaxed);
+	statistics.gradientEvaluationCount = gradientEvaluationCount.load(std::memory_order_relaxed);
+	statistics.sortingTime = sortingTime;
+	statistics.factorizationTime = factorizationTime;
+	statistics.solvingTime = solvingTime;
+	statistics.lengthIntegrationTime = lengthIntegrationTime;
+	statistics.parametrizationTime = parametrizationTime;
+	return statistics;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::StatisticsRecorder::add(const Statistics& statistics)
+{
+	addCounters(statistics);
+	addTimes(statistics);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::StatisticsRecorder::addCounters(const Statistics& statistics)
+{
+	// counters are independent from each other, so they do not need to be ordered, and most evaluations leave some of them unchanged
+	const auto addCounter = [](std::atomic<uint64_t>& counter, const uint64_t& amount)
+	{
+		if(amount > 0)
+		{
+			counter.fetch_add(amount, std::memory_order_relaxed);
+		}
+	};
+	addCounter(evaluationCount, statistics.evaluationCount);
+	addCounter(segmentSearchCount, statistics.segmentSearchCount);
+	addCounter(scannedSegmentCount, statistics.scannedSegmentCount);
+	addCounter(rootFindingCount, statistics.rootFindingCount);
+	addCounter(rootFindingIterationCount, statistics.rootFindingIterationCount);
+	addCounter(quadratureCount, statistics.quadratureCount);
+	addCounter(gradientEvaluationCount, statistics.gradientEvaluationCount);
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::StatisticsRecorder::addTimes(const Statistics& statistics)
+{
+	sortingTime += statistics.sortingTime;
+	factorizationTime += statistics.factorizationTime;
+	solvingTime += statistics.solvingTime;
+	lengthIntegrationTime += statistics.lengthIntegrationTime;
+	parametrizationTime += statistics.parametrizationTime;
+}
+
+template<typename T, int Dim>
+void simpline<T, Dim>::StatisticsRecorder::setTraceCallback(const TraceCallback& traceCallback)
+{
+	this->traceCallback = traceCallback;
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::StatisticsScope::StatisticsScope(StatisticsRecorder& recorder, const char* operation, double Statistics::* time):
+		recorder(&recorder), operation(operation), time(time), outermost(simplineInternal::statisticsScopeDepth++ == 0), timed(false), startCounters(),
+		startTime()
+{
+	if(!outermost)
+	{
+		return;
+	}
+	
+	const simplineInternal::EvaluationCounters& counters = simplineInternal::threadCounters;
+	startCounters.segmentSearchCount = counters.segmentSearchCount;
+	startCounters.scannedSegmentCount = counters.scannedSegmentCount;
+	startCounters.rootFindingCount = counters.rootFindingCount;
+	startCounters.rootFindingIterationCount = counters.rootFindingIterationCount;
+	startCounters.quadratureCount = counters.quadratureCount;
+	startCounters.gradientEvaluationCount = counters.gradientEvaluationCount;
+	
+	// reading the clock would cost as much as a whole evaluation, so evaluations are only timed for tracing
+	timed = time || (operation && recorder.traceCallback);
+	if(timed)
+	{
+		startTime = std::chrono::steady_clock::now();
+	}
+}
+
+template<typename T, int Dim>
+simpline<T, Dim>::StatisticsScope::~StatisticsScope()
+{
+	simplineInternal::statisticsScopeDepth--;
+	if(!outermost)
+	{
+		return;
+	}
+	
+	const simplineInternal::EvaluationCounters& counters = simplineInternal::threadCounters;
+	Statistics statistics;
+	statistics.evaluationCount = operation && !time ? 1 : 0;
+	statistics.segmentSearchCount = counters.segmentSearchCount - startCounters.segmentSearchCount;
+	statistics.scannedSegmentCount = counters.scannedSegmentCount - startCounters.scannedSegmentCount;
+	statistics.rootFindingCount = counters.rootFindingCount - startCounters.rootFindingCount;
+	statistics.rootFindingIterationCount = counters.rootFindingIterationCount - startCounters.rootFindingIterationCount;
+	statistics.quadratureCount = counters.quadratureCount - startCounters.quadratureCount;
+	statistics.gradientEvaluationCount = counters.gradientEvaluationCount - startCounters.gradientEvaluationCount;
+	const double duration = timed ? std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() : 0;
+	recorder->addCounters(statistics);
+	if(time)
+	{
+		statistics.*time = duration;
+		recorder->addTimes(statistics);
+	}
+	
+	if(operation && recorder->traceCallback)
+	{
+		recorder->traceCallback({operation, statistics, duration});
+	}
+}
+
+#endif
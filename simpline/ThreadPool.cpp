@@ -0,0 +1 @@
+#include "ThreadPoolImpl.h"
@@ -0,0 +1,75 @@
+#ifndef SIMPLINE_THREAD_POOL_H
+#define SIMPLINE_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// work-stealing thread pool shared by splines of all types, each worker takes tasks from the front of its own queue and steals from the back of the
+// other queues when it is empty, the calling thread also executes tasks while it waits for them
+class SimplineThreadPool
+{
+public:
+	SimplineThreadPool();
+	
+	explicit SimplineThreadPool(const size_t& workerCount);
+	
+	~SimplineThreadPool();
+	
+	SimplineThreadPool(const SimplineThreadPool&) = delete;
+	
+	SimplineThreadPool& operator=(const SimplineThreadPool&) = delete;
+	
+	size_t getWorkerCount() const;
+	
+	// calls function(first, last) on consecutive ranges of [0, count) of at most chunkSize items and returns once all of them are done, the first
+	// exception thrown by the function is rethrown in the calling thread
+	void parallelFor(const size_t& count, const size_t& chunkSize, const std::function<void(const size_t&, const size_t&)>& function);
+
+private:
+	struct Job
+	{
+		const std::function<void(const size_t&, const size_t&)>* function;
+		std::mutex mutex;
+		// protected by the mutex, so that the job is not destroyed while a worker still uses it
+		size_t remainingTaskCount;
+		std::condition_variable condition;
+		std::exception_ptr exception;
+	};
+	
+	struct Task
+	{
+		Job* job;
+		size_t first;
+		size_t last;
+	};
+	
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+	
+	void work(const size_t& workerIndex);
+	
+	bool popTask(const size_t& queueIndex, Task& task);
+	
+	void runTask(const Task& task);
+	
+	std::vector<std::thread> workers;
+	// one queue per worker, plus one for the calling threads
+	std::vector<std::unique_ptr<TaskQueue>> queues;
+	std::atomic<size_t> nextQueueIndex;
+	std::mutex wakeMutex;
+	std::condition_variable wakeCondition;
+	size_t pendingTaskCount;
+	bool stopping;
+};
+
+#endif
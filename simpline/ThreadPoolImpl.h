@@ -0,0 +1,187 @@
+#ifndef SIMPLINE_THREAD_POOL_IMPL_H
+#define SIMPLINE_THREAD_POOL_IMPL_H
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+// the thread pool is not a template, its functions are only inline when they are compiled in every translation unit
+#ifdef SIMPLINE_HEADER_ONLY
+#define SIMPLINE_INLINE inline
+#else
+#define SIMPLINE_INLINE
+#endif
+
+SIMPLINE_INLINE SimplineThreadPool::SimplineThreadPool():
+		SimplineThreadPool(std::max(std::thread::hardware_concurrency(), 1u) - 1)
+{
+}
+
+SIMPLINE_INLINE SimplineThreadPool::SimplineThreadPool(const size_t& workerCount):
+		nextQueueIndex(0), pendingTaskCount(0), stopping(false)
+{
+	for(size_t i = 0; i <= workerCount; i++)
+	{
+		queues.emplace_back(new TaskQueue());
+	}
+	
+	for(size_t i = 0; i < workerCount; i++)
+	{
+		workers.emplace_back(&SimplineThreadPool::work, this, i);
+	}
+}
+
+SIMPLINE_INLINE SimplineThreadPool::~SimplineThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		stopping = true;
+	}
+	wakeCondition.notify_all();
+	
+	for(std::thread& worker: workers)
+	{
+		worker.join();
+	}
+}
+
+SIMPLINE_INLINE size_t SimplineThreadPool::getWorkerCount() const
+{
+	return workers.size();
+}
+
+SIMPLINE_INLINE void SimplineThreadPool::parallelFor(const size_t& count, const size_t& chunkSize,
+													 const std::function<void(const size_t&, const size_t&)>& function)
+{
+	const size_t taskCount = (count + chunkSize - 1) / chunkSize;
+	if(taskCount <= 1 || workers.empty())
+	{
+		for(size_t first = 0; first < count; first += chunkSize)
+		{
+			function(first, std::min(first + chunkSize, count));
+		}
+		return;
+	}
+	
+	Job job;
+	job.function = &function;
+	job.remainingTaskCount = taskCount;
+	
+	// tasks are counted before being pushed, since workers can pop them as soon as they are in a queue
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		pendingTaskCount += taskCount;
+	}
+	
+	// tasks are dealt round-robin to the queues so that every worker starts on its own range
+	const size_t firstQueueIndex = nextQueueIndex.fetch_add(1);
+	for(size_t i = 0; i < taskCount; i++)
+	{
+		TaskQueue& queue = *queues[(firstQueueIndex + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back({&job, i * chunkSize, std::min((i + 1) * chunkSize, count)});
+	}
+	wakeCondition.notify_all();
+	
+	Task task;
+	while(true)
+	{
+		{
+			std::lock_guard<std::mutex> lock(job.mutex);
+			if(job.remainingTaskCount == 0)
+			{
+				break;
+			}
+		}
+		
+		if(popTask(workers.size(), task))
+		{
+			runTask(task);
+		}
+		else
+		{
+			std::unique_lock<std::mutex> lock(job.mutex);
+			job.condition.wait(lock, [&job]() { return job.remainingTaskCount == 0; });
+		}
+	}
+	
+	if(job.exception)
+	{
+		std::rethrow_exception(job.exception);
+	}
+}
+
+SIMPLINE_INLINE void SimplineThreadPool::work(const size_t& workerIndex)
+{
+	Task task;
+	while(true)
+	{
+		if(popTask(workerIndex, task))
+		{
+			runTask(task);
+			continue;
+		}
+		
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		wakeCondition.wait(lock, [this]() { return stopping || pendingTaskCount > 0; });
+		if(stopping && pendingTaskCount == 0)
+		{
+			return;
+		}
+	}
+}
+
+SIMPLINE_INLINE bool SimplineThreadPool::popTask(const size_t& queueIndex, Task& task)
+{
+	for(size_t i = 0; i < queues.size(); i++)
+	{
+		TaskQueue& queue = *queues[(queueIndex + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(queue.tasks.empty())
+		{
+			continue;
+		}
+		
+		if(i == 0)
+		{
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+		}
+		else
+		{
+			task = queue.tasks.back();
+			queue.tasks.pop_back();
+		}
+		
+		std::lock_guard<std::mutex> wakeLock(wakeMutex);
+		pendingTaskCount--;
+		return true;
+	}
+	
+	return false;
+}
+
+SIMPLINE_INLINE void SimplineThreadPool::runTask(const Task& task)
+{
+	Job& job = *task.job;
+	try
+	{
+		(*job.function)(task.first, task.last);
+	}
+	catch(...)
+	{
+		std::lock_guard<std::mutex> lock(job.mutex);
+		if(!job.exception)
+		{
+			job.exception = std::current_exception();
+		}
+	}
+	
+	// the job lives on the stack of the calling thread, which returns once it sees the count at zero under the lock
+	std::lock_guard<std::mutex> lock(job.mutex);
+	if(--job.remainingTaskCount == 0)
+	{
+		job.condition.notify_all();
+	}
+}
+
+#endif
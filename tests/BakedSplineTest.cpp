@@ -0,0 +1,84 @@
+#include "TestUtilities.h"
+#include "../simpline/Constants.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+typedef simpline<double, 3> Simpline;
+
+// baked splines interpolate fresh evaluations of the spline, their reported error must hold between the grid times
+void testBakedErrorAgainstFreshEvaluations()
+{
+	const double tolerance = 1e-5;
+	const Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(50, 11), 1.0, 1e-8);
+	const Simpline::BakedSpline bakedSpline(spline, tolerance);
+	Simpline::ThreadPool threadPool(2);
+	const Simpline::BakedSpline parallelBakedSpline(spline, tolerance, threadPool);
+	SIMPLINE_CHECK(bakedSpline.getMaximumError() <= tolerance);
+	SIMPLINE_CHECK(parallelBakedSpline.getTimeStep() == bakedSpline.getTimeStep());
+	SIMPLINE_CHECK(parallelBakedSpline.getMaximumError() == bakedSpline.getMaximumError());
+	
+	// grid times are samples of the spline
+	const size_t intervalCount = bakedSpline.getMemoryUsage() / sizeof(Simpline::SegmentCoefficients);
+	double gridError = 0;
+	for(size_t i = 0; i < intervalCount; i += 7)
+	{
+		const double time = i * bakedSpline.getTimeStep();
+		gridError = std::max(gridError, (bakedSpline.getValue(time) - spline.getValue(time)).norm());
+	}
+	SIMPLINE_CHECK(gridError <= 1e-12);
+	
+	// the error is only measured at three points per interval, random times may exceed it slightly
+	std::mt19937 generator(2);
+	std::uniform_real_distribution<double> timeDistribution(0, spline.getDuration());
+	double error = 0;
+	for(size_t i = 0; i < 20000; i++)
+	{
+		const double time = timeDistribution(generator);
+		error = std::max(error, (bakedSpline.getValue(time) - spline.getValue(time)).norm());
+	}
+	SIMPLINE_CHECK(error <= 2 * tolerance);
+}
+
+void testBakedSplineErrors()
+{
+	const Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(10, 13), 1.0);
+	SIMPLINE_CHECK_THROWS(Simpline::BakedSpline(spline, 0));
+	SIMPLINE_CHECK_THROWS(Simpline::BakedSpline(Simpline::ConstantSpeedSpline(), 1e-3));
+	const Simpline::BakedSpline bakedSpline(spline, 1e-3);
+	SIMPLINE_CHECK_THROWS(bakedSpline.getValue(-1));
+	SIMPLINE_CHECK_THROWS(bakedSpline.getValue(bakedSpline.getDuration() + 1));
+	SIMPLINE_CHECK_THROWS(Simpline::BakedSpline().getValue(0));
+}
+
+// fresh evaluations are only as accurate as the tolerance of the spline, which slows the decrease of the error, tolerances out of reach must be
+// rejected from the rate of that decrease instead of refining the grid up to its maximum size
+void testUnreachableToleranceIsRejected()
+{
+	const Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(50, 21), 1.0, 1e-4);
+	std::string message;
+	try
+	{
+		Simpline::BakedSpline(spline, 1e-12);
+	}
+	catch(const std::runtime_error& error)
+	{
+		message = error.what();
+	}
+	SIMPLINE_CHECK(message.find("cannot be reached") != std::string::npos);
+	// the message reports the grid that was reached, which is far from maximumBakedIntervalCount
+	const size_t intervalCountPosition = message.find(" with ") + 6;
+	SIMPLINE_CHECK(std::stoul(message.substr(intervalCountPosition)) < simplineInternal::maximumBakedIntervalCount / 16);
+	
+	// reachable tolerances of the same spline are still met
+	SIMPLINE_CHECK(Simpline::BakedSpline(spline, 1e-3).getMaximumError() <= 1e-3);
+}
+
+int main()
+{
+	testBakedErrorAgainstFreshEvaluations();
+	testBakedSplineErrors();
+	testUnreachableToleranceIsRejected();
+	return reportFailures();
+}
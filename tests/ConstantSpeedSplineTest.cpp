@@ -0,0 +1,278 @@
+#include "TestUtilities.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+typedef simpline<double, 3> Simpline;
+
+// largest distance between the values of warm started evaluations and those of fresh ones at the same times
+double getCursorDrift(const Simpline::ConstantSpeedSpline& spline, const double& timeStep, const double& endTime)
+{
+	double drift = 0;
+	Simpline::SplineCursor cursor;
+	for(size_t i = 0; i * timeStep <= endTime; i++)
+	{
+		drift = std::max(drift, (spline.getValue(i * timeStep, cursor) - spline.getValue(i * timeStep)).norm());
+	}
+	return drift;
+}
+
+double getSamplerDrift(const Simpline::ConstantSpeedSpline& spline, const double& timeStep)
+{
+	double drift = 0;
+	Simpline::ConstantSpeedSpline::Sampler sampler = spline.sampler(timeStep);
+	Simpline::State state;
+	for(double time = sampler.getTime(); sampler.next(state); time = sampler.getTime())
+	{
+		drift = std::max(drift, (state.value - spline.getValue(time)).norm());
+	}
+	return drift;
+}
+
+double getBatchDrift(const Simpline::ConstantSpeedSpline& spline, const double& timeStep)
+{
+	std::vector<double> times;
+	for(size_t i = 0; i * timeStep <= spline.getDuration(); i++)
+	{
+		times.push_back(i * timeStep);
+	}
+	std::vector<double> values(3 * times.size());
+	spline.evaluate(times.data(), times.size(), values.data(), nullptr);
+	
+	double drift = 0;
+	for(size_t i = 0; i < times.size(); i++)
+	{
+		drift = std::max(drift, (Eigen::Map<const Simpline::Vector>(values.data() + 3 * i) - spline.getValue(times[i])).norm());
+	}
+	return drift;
+}
+
+// warm started inversions used to accumulate the error of the previous ones over thousands of small steps in the same segment
+void testWarmStartDoesNotDrift()
+{
+	const std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(300, 3);
+	for(const double tolerance: {1e-4, 1e-8})
+	{
+		const Simpline::ConstantSpeedSpline spline(points, 1.0, tolerance);
+		// the tolerance applies to the parameter value, which is the chord length, so values are within a small multiple of it
+		SIMPLINE_CHECK(getCursorDrift(spline, 1e-3, spline.getDuration()) <= 2 * tolerance);
+		SIMPLINE_CHECK(getCursorDrift(spline, 1e-4, 20.0) <= 2 * tolerance);
+		SIMPLINE_CHECK(getSamplerDrift(spline, 5e-4) <= 2 * tolerance);
+		SIMPLINE_CHECK(getBatchDrift(spline, 1e-3) <= 2 * tolerance);
+	}
+}
+
+// chunks of a batch warm start each of their queries from the previous one, with or without a thread pool the results must match fresh evaluations
+void testBatchEvaluationMatchesFreshEvaluations()
+{
+	const double tolerance = 1e-4;
+	const Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(100, 5), 1.0, tolerance);
+	// many queries per segment and several chunks
+	std::vector<double> times;
+	for(size_t i = 0; i * 2e-4 <= spline.getDuration(); i++)
+	{
+		times.push_back(i * 2e-4);
+	}
+	const size_t count = times.size();
+	std::vector<double> values(3 * count);
+	std::vector<double> gradients(3 * count);
+	spline.evaluate(times.data(), count, values.data(), gradients.data());
+	std::vector<double> parallelValues(3 * count);
+	std::vector<double> parallelGradients(3 * count);
+	Simpline::ThreadPool threadPool(4);
+	spline.evaluate(times.data(), count, parallelValues.data(), parallelGradients.data(), threadPool);
+	std::vector<Simpline::State> states(count);
+	spline.evaluateStates(times.data(), count, states.data(), threadPool);
+	
+	double valueError = 0;
+	double gradientError = 0;
+	double stateError = 0;
+	for(size_t i = 0; i < count; i++)
+	{
+		const Simpline::Vector value = spline.getValue(times[i]);
+		const Simpline::Vector gradient = spline.getGradient(times[i]);
+		valueError = std::max(valueError, (Eigen::Map<const Simpline::Vector>(values.data() + 3 * i) - value).norm());
+		gradientError = std::max(gradientError, (Eigen::Map<const Simpline::Vector>(gradients.data() + 3 * i) - gradient).norm());
+		stateError = std::max(stateError, (states[i].value - value).norm());
+	}
+	SIMPLINE_CHECK(valueError <= 2 * tolerance);
+	// the gradient is a unit vector times the speed, its error is the one of the parameter value times the curvature
+	SIMPLINE_CHECK(gradientError <= 1e-2);
+	SIMPLINE_CHECK(stateError <= 2 * tolerance);
+	SIMPLINE_CHECK(parallelValues == values);
+	SIMPLINE_CHECK(parallelGradients == gradients);
+}
+
+// real-time loops hold a cursor across ticks, possibly going back in time, successes must be as accurate as fresh evaluations
+void testTryEvaluationsWithHeldCursor()
+{
+	const double tolerance = 1e-4;
+	const Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(100, 7), 1.0, tolerance);
+	Simpline::SplineCursor cursor;
+	double valueError = 0;
+	double stateError = 0;
+	double gradientError = 0;
+	bool allSucceeded = true;
+	for(size_t i = 0; i * 1e-3 <= spline.getDuration(); i++)
+	{
+		// every tenth tick goes back by a few steps
+		const double time = i % 10 == 9 ? (i - 3) * 1e-3 : i * 1e-3;
+		Simpline::Vector value;
+		Simpline::Vector gradient;
+		Simpline::State state;
+		allSucceeded = allSucceeded && spline.tryGetValue(time, value, cursor) == Simpline::SUCCESS;
+		allSucceeded = allSucceeded && spline.tryGetGradient(time, gradient, cursor) == Simpline::SUCCESS;
+		allSucceeded = allSucceeded && spline.tryEvaluateState(time, state, cursor) == Simpline::SUCCESS;
+		const Simpline::Vector freshValue = spline.getValue(time);
+		valueError = std::max(valueError, (value - freshValue).norm());
+		gradientError = std::max(gradientError, (gradient - spline.getGradient(time)).norm());
+		stateError = std::max(stateError, (state.value - freshValue).norm());
+	}
+	SIMPLINE_CHECK(allSucceeded);
+	SIMPLINE_CHECK(valueError <= 2 * tolerance);
+	SIMPLINE_CHECK(gradientError <= 1e-2);
+	SIMPLINE_CHECK(stateError <= 2 * tolerance);
+	
+	Simpline::Vector value;
+	SIMPLINE_CHECK(spline.tryGetValue(spline.getDuration() + 1, value, cursor) == Simpline::CLAMPED);
+	SIMPLINE_CHECK((value - spline.getValue(spline.getDuration())).norm() <= 2 * tolerance);
+	SIMPLINE_CHECK(spline.tryGetValue(-1, value, cursor) == Simpline::CLAMPED);
+	SIMPLINE_CHECK((value - spline.getValue(0)).norm() <= 2 * tolerance);
+	SIMPLINE_CHECK(spline.tryGetValue(std::numeric_limits<double>::quiet_NaN(), value, cursor) == Simpline::INVALID_ARGUMENT);
+	Simpline::SplineCursor emptyCursor;
+	SIMPLINE_CHECK(Simpline::ConstantSpeedSpline().tryGetValue(0, value, emptyCursor) == Simpline::EMPTY_SPLINE);
+}
+
+// the Frenet frame of a helix of radius r and pitch c per radian is known in closed form, its curvature is r / (r^2 + c^2) whatever the parametrization
+// and the normal points horizontally to the axis, a circle being the helix without pitch
+void testFrenetFrameOfHelix()
+{
+	const double radius = 2.0;
+	for(const double pitch: {0.0, 0.5})
+	{
+		std::vector<double> angles;
+		std::vector<Simpline::Vector> points;
+		for(size_t i = 0; i <= 400; i++)
+		{
+			const double angle = i * 0.05;
+			angles.push_back(angle);
+			points.push_back(Simpline::Vector(radius * std::cos(angle), radius * std::sin(angle), pitch * angle));
+		}
+		const Simpline::ConstantSpeedSpline spline(points, 1.0, 1e-10);
+		const double helixLength = std::sqrt(radius * radius + pitch * pitch);
+		const double expectedCurvature = radius / (helixLength * helixLength);
+		
+		double curvatureError = 0;
+		double frameError = 0;
+		double orthonormalityError = 0;
+		// the natural end conditions flatten the spline near its ends
+		for(double time = spline.getDuration() / 10; time < spline.getDuration() * 0.9; time += 0.1)
+		{
+			const Simpline::State state = spline.evaluateState(time, true);
+			const double angle = std::atan2(state.value.y(), state.value.x());
+			const Simpline::Vector tangent = Simpline::Vector(-radius * std::sin(angle), radius * std::cos(angle), pitch) / helixLength;
+			const Simpline::Vector normal(-std::cos(angle), -std::sin(angle), 0);
+			const Simpline::Vector binormal = Simpline::Vector(pitch * std::sin(angle), -pitch * std::cos(angle), radius) / helixLength;
+			curvatureError = std::max(curvatureError, std::abs(state.curvature - expectedCurvature));
+			frameError = std::max({frameError, (state.tangent - tangent).norm(), (state.normal - normal).norm(), (state.binormal - binormal).norm()});
+			
+			Eigen::Matrix3d frame;
+			frame << state.tangent, state.normal, state.binormal;
+			orthonormalityError = std::max(orthonormalityError, (frame.transpose() * frame - Eigen::Matrix3d::Identity()).norm());
+			SIMPLINE_CHECK(std::abs(frame.determinant() - 1) <= 1e-9);
+		}
+		
+		// parametrized by the angle, the speed is not one but the curvature is the same
+		const Simpline::ParametrizedSpline parametrizedSpline(angles, points);
+		for(double angle = 2.0; angle < 18.0; angle += 0.1)
+		{
+			const Simpline::State state = parametrizedSpline.evaluateState(angle, true);
+			curvatureError = std::max(curvatureError, std::abs(state.curvature - expectedCurvature));
+			frameError = std::max(frameError, (state.normal - Simpline::Vector(-std::cos(angle), -std::sin(angle), 0)).norm());
+			SIMPLINE_CHECK(std::abs(state.velocity.norm() - helixLength) <= 1e-3);
+		}
+		SIMPLINE_CHECK(curvatureError <= 1e-3 * expectedCurvature);
+		SIMPLINE_CHECK(frameError <= 1e-5);
+		SIMPLINE_CHECK(orthonormalityError <= 1e-12);
+	}
+	
+	// a straight line has no curvature, normal or binormal
+	const Simpline::ConstantSpeedSpline line({Simpline::Vector(0, 0, 0), Simpline::Vector(1, 1, 0), Simpline::Vector(2, 2, 0)}, 1.0);
+	const Simpline::State state = line.evaluateState(1.0, true);
+	SIMPLINE_CHECK(state.curvature <= 1e-12);
+	SIMPLINE_CHECK(state.normal.isZero());
+	SIMPLINE_CHECK(state.binormal.isZero());
+	SIMPLINE_CHECK((state.tangent - Simpline::Vector(1, 1, 0).normalized()).norm() <= 1e-12);
+	// frames are only computed on request
+	SIMPLINE_CHECK(line.evaluateState(1.0).tangent.isZero());
+}
+
+// duration, length and values along the spline, which must not change when a modification is rejected
+std::vector<double> getFingerprint(const Simpline::ConstantSpeedSpline& spline)
+{
+	std::vector<double> fingerprint = {spline.getDuration(), spline.getLength()};
+	for(size_t i = 0; i <= 1000; i++)
+	{
+		const Simpline::Vector value = spline.getValue(spline.getDuration() * i / 1000);
+		fingerprint.insert(fingerprint.end(), value.data(), value.data() + 3);
+	}
+	return fingerprint;
+}
+
+void testRejectedAppendsLeaveSplineUnchanged()
+{
+	const std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(300, 23);
+	Simpline::ConstantSpeedSpline spline(points, 2.0);
+	const std::vector<double> fingerprint = getFingerprint(spline);
+	const Simpline::Vector newPoint = points.back() + Simpline::Vector(1, 0, 0);
+	
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({newPoint}, 0.0));
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({newPoint}, 1.0));
+	// zero chords, with the last point of the spline and between the new points
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({points.back()}));
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({newPoint, newPoint}));
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({newPoint, Simpline::Vector::Constant(std::numeric_limits<double>::quiet_NaN())}));
+	SIMPLINE_CHECK(getFingerprint(spline) == fingerprint);
+	
+	std::vector<Simpline::Vector> allPoints = points;
+	allPoints.push_back(newPoint);
+	spline.appendPoints({newPoint});
+	const Simpline::ConstantSpeedSpline expectedSpline(allPoints, 2.0);
+	SIMPLINE_CHECK(std::abs(spline.getDuration() - expectedSpline.getDuration()) <= 1e-6);
+}
+
+void testRejectedReplacementsLeaveSplineUnchanged()
+{
+	std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(300, 27);
+	Simpline::ConstantSpeedSpline spline(points, 2.0);
+	const std::vector<double> fingerprint = getFingerprint(spline);
+	const Simpline::Vector newPoint = points[150] + Simpline::Vector(0.5, 0, 0);
+	
+	SIMPLINE_CHECK_THROWS(spline.movePoint(150, newPoint, 2.0));
+	SIMPLINE_CHECK_THROWS(spline.movePoint(150, newPoint, 0.0));
+	SIMPLINE_CHECK_THROWS(spline.movePoint(300, newPoint));
+	// zero chords with the neighbours of the replaced points and between them
+	SIMPLINE_CHECK_THROWS(spline.movePoint(150, points[149]));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(150, {newPoint, newPoint}));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(150, {newPoint, Simpline::Vector::Constant(std::numeric_limits<double>::quiet_NaN())}));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(299, {newPoint, newPoint}));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(std::numeric_limits<size_t>::max(), {newPoint}));
+	SIMPLINE_CHECK(getFingerprint(spline) == fingerprint);
+	
+	spline.movePoint(150, newPoint);
+	points[150] = newPoint;
+	const Simpline::ConstantSpeedSpline expectedSpline(points, 2.0);
+	SIMPLINE_CHECK(std::abs(spline.getDuration() - expectedSpline.getDuration()) <= 1e-6);
+}
+
+int main()
+{
+	testWarmStartDoesNotDrift();
+	testBatchEvaluationMatchesFreshEvaluations();
+	testTryEvaluationsWithHeldCursor();
+	testFrenetFrameOfHelix();
+	testRejectedAppendsLeaveSplineUnchanged();
+	testRejectedReplacementsLeaveSplineUnchanged();
+	return reportFailures();
+}
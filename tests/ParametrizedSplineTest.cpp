@@ -0,0 +1,431 @@
+#include "TestUtilities.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+typedef simpline<double, 3> Simpline;
+
+// code written before splines had a dimension must keep compiling, with a deprecation warning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+static_assert(std::is_same<simpline<double>::Vector3, simpline<double>::Vector>::value, "Vector3 must be the 3D point type.");
+static_assert(std::is_same<simpline<float>::Matrix3X, simpline<float>::Matrix>::value, "Matrix3X must be the 3D matrix type.");
+#pragma GCC diagnostic pop
+
+// second derivatives of the natural spline solved with a dense factorization of the full system
+std::vector<Simpline::Vector> solveDenseSecondDerivatives(const std::vector<double>& parameterValues, const std::vector<Simpline::Vector>& points)
+{
+	const size_t pointCount = points.size();
+	Eigen::MatrixXd system = Eigen::MatrixXd::Zero(pointCount, pointCount);
+	Eigen::MatrixXd rightHandSides = Eigen::MatrixXd::Zero(pointCount, 3);
+	system(0, 0) = 1;
+	system(pointCount - 1, pointCount - 1) = 1;
+	for(size_t i = 1; i + 1 < pointCount; i++)
+	{
+		const double previousIntervalLength = parameterValues[i] - parameterValues[i - 1];
+		const double nextIntervalLength = parameterValues[i + 1] - parameterValues[i];
+		system(i, i - 1) = previousIntervalLength;
+		system(i, i) = 2 * (previousIntervalLength + nextIntervalLength);
+		system(i, i + 1) = nextIntervalLength;
+		rightHandSides.row(i) = (6 * ((points[i + 1] - points[i]) / nextIntervalLength - (points[i] - points[i - 1]) / previousIntervalLength)).transpose();
+	}
+	const Eigen::MatrixXd solution = system.partialPivLu().solve(rightHandSides);
+	
+	std::vector<Simpline::Vector> secondDerivatives(pointCount);
+	for(size_t i = 0; i < pointCount; i++)
+	{
+		secondDerivatives[i] = solution.row(i).transpose();
+	}
+	return secondDerivatives;
+}
+
+// the tridiagonal solver must give the same natural spline as the full system, interpolating the points with continuous derivatives
+void testSolverMatchesDenseSystem()
+{
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> intervalDistribution(0.1, 2.0);
+	const std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(200, 1);
+	std::vector<double> parameterValues(points.size());
+	parameterValues[0] = 0;
+	for(size_t i = 1; i < parameterValues.size(); i++)
+	{
+		parameterValues[i] = parameterValues[i - 1] + intervalDistribution(generator);
+	}
+	
+	// points are given out of order, the spline sorts them by parameter value
+	std::vector<double> shuffledParameterValues = parameterValues;
+	std::vector<Simpline::Vector> shuffledPoints = points;
+	std::reverse(shuffledParameterValues.begin(), shuffledParameterValues.end());
+	std::reverse(shuffledPoints.begin(), shuffledPoints.end());
+	const Simpline::ParametrizedSpline spline(shuffledParameterValues, shuffledPoints);
+	
+	const std::vector<Simpline::Vector> secondDerivatives = solveDenseSecondDerivatives(parameterValues, points);
+	const double tolerance = 1e-9;
+	for(size_t i = 0; i < points.size(); i++)
+	{
+		SIMPLINE_CHECK((spline.getValue(parameterValues[i]) - points[i]).norm() <= tolerance);
+		SIMPLINE_CHECK((spline.evaluateState(parameterValues[i]).acceleration - secondDerivatives[i]).norm() <= tolerance);
+	}
+	SIMPLINE_CHECK(spline.evaluateState(parameterValues.front()).acceleration.norm() <= tolerance);
+	SIMPLINE_CHECK(spline.evaluateState(parameterValues.back()).acceleration.norm() <= tolerance);
+	
+	// derivatives on both sides of the knots, the step is small enough for the third derivative to be negligible
+	const double step = 1e-7;
+	for(size_t i = 1; i + 1 < points.size(); i++)
+	{
+		const Simpline::State before = spline.evaluateState(parameterValues[i] - step);
+		const Simpline::State after = spline.evaluateState(parameterValues[i]);
+		SIMPLINE_CHECK((before.value - after.value).norm() <= 1e-5);
+		SIMPLINE_CHECK((before.velocity - after.velocity).norm() <= 1e-4);
+		SIMPLINE_CHECK((before.acceleration - after.acceleration).norm() <= 1e-3);
+	}
+}
+
+void testSolverTwoPoints()
+{
+	const std::vector<double> parameterValues = {0, 2};
+	const std::vector<Simpline::Vector> points = {Simpline::Vector(0, 0, 0), Simpline::Vector(2, 4, 6)};
+	const Simpline::ParametrizedSpline spline(parameterValues, points);
+	SIMPLINE_CHECK((spline.getValue(1) - Simpline::Vector(1, 2, 3)).norm() <= 1e-12);
+	SIMPLINE_CHECK((spline.getGradient(0.5) - Simpline::Vector(1, 2, 3)).norm() <= 1e-12);
+}
+
+// values along the spline and its length, which must not change when a modification is rejected
+std::vector<double> getFingerprint(const Simpline::ParametrizedSpline& spline, const double& lastParameterValue)
+{
+	std::vector<double> fingerprint(1, spline.getLength());
+	for(size_t i = 0; i <= 1000; i++)
+	{
+		const Simpline::Vector value = spline.getValue(lastParameterValue * i / 1000);
+		fingerprint.insert(fingerprint.end(), value.data(), value.data() + 3);
+	}
+	return fingerprint;
+}
+
+std::vector<double> createParameterValues(const size_t& count)
+{
+	std::vector<double> parameterValues(count);
+	for(size_t i = 0; i < count; i++)
+	{
+		parameterValues[i] = i;
+	}
+	return parameterValues;
+}
+
+// rejected appends must leave the spline as it was, and later appends must behave as if nothing happened
+void testRejectedAppendsLeaveSplineUnchanged()
+{
+	const std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(300, 21);
+	Simpline::ParametrizedSpline spline(createParameterValues(300), points);
+	const std::vector<double> fingerprint = getFingerprint(spline, 299);
+	const Simpline::Vector newPoint(1, 2, 3);
+	
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({300.5}, {newPoint}, 0.0));
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({300.5}, {newPoint}, 1.5));
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({400, 300.5, 299}, {newPoint, newPoint, newPoint}));
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({400, 300.5, 300.5}, {newPoint, newPoint, newPoint}));
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({300.5, std::numeric_limits<double>::quiet_NaN()}, {newPoint, newPoint}));
+	SIMPLINE_CHECK_THROWS(spline.appendPoints({300.5, 301}, {newPoint}));
+	SIMPLINE_CHECK(getFingerprint(spline, 299) == fingerprint);
+	SIMPLINE_CHECK_THROWS(spline.getValue(300));
+	
+	std::vector<Simpline::Vector> allPoints = points;
+	allPoints.push_back(newPoint);
+	allPoints.push_back(newPoint * 2);
+	spline.appendPoints({301, 300}, {newPoint * 2, newPoint});
+	const Simpline::ParametrizedSpline expectedSpline(createParameterValues(302), allPoints);
+	// the second derivatives are only solved again in a window, up to the decay tolerance
+	SIMPLINE_CHECK(std::abs(spline.getLength() - expectedSpline.getLength()) <= 1e-6);
+	SIMPLINE_CHECK((spline.getValue(300.5) - expectedSpline.getValue(300.5)).norm() <= 1e-6);
+}
+
+void testRejectedReplacementsLeaveSplineUnchanged()
+{
+	std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(300, 25);
+	Simpline::ParametrizedSpline spline(createParameterValues(300), points);
+	const std::vector<double> fingerprint = getFingerprint(spline, 299);
+	const Simpline::Vector newPoint(1, 2, 3);
+	
+	SIMPLINE_CHECK_THROWS(spline.movePoint(150, newPoint, 2.0));
+	SIMPLINE_CHECK_THROWS(spline.movePoint(150, newPoint, 0.0));
+	SIMPLINE_CHECK_THROWS(spline.movePoint(300, newPoint));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(100, {newPoint, newPoint}, -1.0));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(299, {newPoint, newPoint}));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(0, {}));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(std::numeric_limits<size_t>::max(), {newPoint}));
+	SIMPLINE_CHECK_THROWS(spline.replaceRange(100, {newPoint, Simpline::Vector::Constant(std::numeric_limits<double>::quiet_NaN())}));
+	SIMPLINE_CHECK_THROWS(spline.movePoint(150, Simpline::Vector::Constant(std::numeric_limits<double>::infinity())));
+	SIMPLINE_CHECK(getFingerprint(spline, 299) == fingerprint);
+	
+	spline.movePoint(150, newPoint);
+	points[150] = newPoint;
+	const Simpline::ParametrizedSpline expectedSpline(createParameterValues(300), points);
+	SIMPLINE_CHECK(std::abs(spline.getLength() - expectedSpline.getLength()) <= 1e-6);
+	SIMPLINE_CHECK((spline.getValue(150.5) - expectedSpline.getValue(150.5)).norm() <= 1e-6);
+}
+
+// the adaptive rule must meet the requested tolerance on every segment, so that its total error estimate is below the relative tolerance times the
+// length, and its estimates must bound the actual error
+void testAdaptiveQuadratureErrorEstimates()
+{
+	const std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(300, 29);
+	const std::vector<double> parameterValues = createParameterValues(300);
+	SIMPLINE_CHECK(std::isnan(Simpline::ParametrizedSpline(parameterValues, points).getLengthErrorEstimate()));
+	
+	Simpline::Quadrature referenceQuadrature;
+	referenceQuadrature.rule = Simpline::Quadrature::ADAPTIVE_GAUSS_KRONROD_15;
+	referenceQuadrature.relativeTolerance = 1e-13;
+	const Simpline::ParametrizedSpline referenceSpline(parameterValues, points, referenceQuadrature);
+	for(const double relativeTolerance: {1e-4, 1e-8})
+	{
+		Simpline::Quadrature quadrature;
+		quadrature.rule = Simpline::Quadrature::ADAPTIVE_GAUSS_KRONROD_15;
+		quadrature.relativeTolerance = relativeTolerance;
+		const Simpline::ParametrizedSpline spline(parameterValues, points, quadrature);
+		const double errorEstimate = spline.getLengthErrorEstimate();
+		SIMPLINE_CHECK(errorEstimate <= relativeTolerance * spline.getLength());
+		SIMPLINE_CHECK(std::abs(spline.getLength() - referenceSpline.getLength()) <= errorEstimate);
+		
+		// partial lengths start and end within segments
+		double partialErrorEstimate;
+		const double partialLength = spline.getLength(10.5, 200.25, partialErrorEstimate);
+		SIMPLINE_CHECK(partialErrorEstimate <= relativeTolerance * partialLength);
+		SIMPLINE_CHECK(std::abs(partialLength - referenceSpline.getLength(10.5, 200.25)) <= partialErrorEstimate);
+	}
+	
+	// with an absolute tolerance alone, each of the 299 segments may have an error up to the tolerance
+	Simpline::Quadrature absoluteQuadrature;
+	absoluteQuadrature.rule = Simpline::Quadrature::ADAPTIVE_GAUSS_KRONROD_15;
+	absoluteQuadrature.absoluteTolerance = 1e-9;
+	absoluteQuadrature.relativeTolerance = 0;
+	const Simpline::ParametrizedSpline absoluteSpline(parameterValues, points, absoluteQuadrature);
+	SIMPLINE_CHECK(absoluteSpline.getLengthErrorEstimate() <= 299 * 1e-9);
+	SIMPLINE_CHECK(std::abs(absoluteSpline.getLength() - referenceSpline.getLength()) <= absoluteSpline.getLengthErrorEstimate());
+}
+
+// on smooth segments the fixed 25-point rule is exact to rounding and the adaptive rule must agree with it, segments of random walks whose gradient
+// nearly vanishes at sharp turns are not smooth enough for that
+void testAdaptiveQuadratureMatchesFixedRule()
+{
+	std::vector<double> angles;
+	std::vector<Simpline::Vector> points;
+	for(size_t i = 0; i <= 200; i++)
+	{
+		angles.push_back(i * 0.1);
+		points.push_back(Simpline::Vector(std::cos(i * 0.1), std::sin(i * 0.1), 0.2 * i * 0.1));
+	}
+	const Simpline::ParametrizedSpline fixedSpline(angles, points);
+	Simpline::Quadrature quadrature;
+	quadrature.rule = Simpline::Quadrature::ADAPTIVE_GAUSS_KRONROD_15;
+	quadrature.relativeTolerance = 1e-12;
+	const Simpline::ParametrizedSpline adaptiveSpline(angles, points, quadrature);
+	SIMPLINE_CHECK(std::abs(adaptiveSpline.getLength() - fixedSpline.getLength()) <= 1e-12 * fixedSpline.getLength());
+	SIMPLINE_CHECK(std::abs(adaptiveSpline.getLength(1.05, 17.3) - fixedSpline.getLength(1.05, 17.3)) <= 1e-12 * fixedSpline.getLength());
+}
+
+// values, gradients and partial lengths at and between the knots, which depend on every coefficient and cumulative length of the spline
+std::vector<double> getConstructionFingerprint(const Simpline::ParametrizedSpline& spline, const std::vector<double>& parameterValues)
+{
+	std::vector<double> fingerprint = {spline.getLength(), spline.getLengthErrorEstimate()};
+	for(size_t i = 0; i + 1 < parameterValues.size(); i++)
+	{
+		for(const double parameterValue: {parameterValues[i], (parameterValues[i] + parameterValues[i + 1]) / 2})
+		{
+			const Simpline::Vector value = spline.getValue(parameterValue);
+			const Simpline::Vector gradient = spline.getGradient(parameterValue);
+			fingerprint.insert(fingerprint.end(), value.data(), value.data() + 3);
+			fingerprint.insert(fingerprint.end(), gradient.data(), gradient.data() + 3);
+			fingerprint.push_back(spline.getLength(parameterValues[0], parameterValue));
+		}
+	}
+	return fingerprint;
+}
+
+// parallel constructions split the segments in chunks but sum the lengths serially, so they must give the same bits as serial ones whatever the
+// number of threads, not-a-number error estimates of the fixed rules are compared through their bits as well
+void testParallelConstructionMatchesSerial()
+{
+	const size_t pointCount = 5000;
+	const std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(pointCount, 31);
+	const std::vector<double> parameterValues = createParameterValues(pointCount);
+	Simpline::Quadrature adaptiveQuadrature;
+	adaptiveQuadrature.rule = Simpline::Quadrature::ADAPTIVE_GAUSS_KRONROD_15;
+	for(const Simpline::Quadrature& quadrature: {Simpline::Quadrature(), adaptiveQuadrature})
+	{
+		const std::vector<double> serialFingerprint = getConstructionFingerprint(Simpline::ParametrizedSpline(parameterValues, points, quadrature),
+																				 parameterValues);
+		const Simpline::ConstantSpeedSpline serialConstantSpeedSpline(points, 1.0, 1e-6, quadrature);
+		const Simpline::KnotBasis basis(parameterValues);
+		const std::vector<std::vector<Simpline::Vector>> pointSets = {points, createRandomWalk<double, 3>(pointCount, 33),
+																	  createRandomWalk<double, 3>(pointCount, 35)};
+		const std::vector<Simpline::ParametrizedSpline> serialSplines = basis.createSplines(pointSets, quadrature);
+		for(const size_t workerCount: {1, 2, 3, 8})
+		{
+			Simpline::ThreadPool threadPool(workerCount);
+			const std::vector<double> parallelFingerprint = getConstructionFingerprint(Simpline::ParametrizedSpline(parameterValues, points, quadrature,
+																												   threadPool), parameterValues);
+			SIMPLINE_CHECK(parallelFingerprint.size() == serialFingerprint.size() &&
+						   std::memcmp(parallelFingerprint.data(), serialFingerprint.data(), serialFingerprint.size() * sizeof(double)) == 0);
+			
+			const Simpline::ConstantSpeedSpline parallelConstantSpeedSpline(points, 1.0, 1e-6, quadrature, threadPool);
+			bool constantSpeedSplinesMatch = parallelConstantSpeedSpline.getDuration() == serialConstantSpeedSpline.getDuration();
+			for(size_t i = 0; i <= 1000; i++)
+			{
+				const double time = serialConstantSpeedSpline.getDuration() * i / 1000;
+				constantSpeedSplinesMatch = constantSpeedSplinesMatch && parallelConstantSpeedSpline.getValue(time) == serialConstantSpeedSpline.getValue(time);
+			}
+			SIMPLINE_CHECK(constantSpeedSplinesMatch);
+			
+			const std::vector<Simpline::ParametrizedSpline> parallelSplines = basis.createSplines(pointSets, quadrature, threadPool);
+			for(size_t i = 0; i < pointSets.size(); i++)
+			{
+				const std::vector<double> serialSplineFingerprint = getConstructionFingerprint(serialSplines[i], parameterValues);
+				const std::vector<double> parallelSplineFingerprint = getConstructionFingerprint(parallelSplines[i], parameterValues);
+				SIMPLINE_CHECK(std::memcmp(parallelSplineFingerprint.data(), serialSplineFingerprint.data(),
+										   serialSplineFingerprint.size() * sizeof(double)) == 0);
+			}
+		}
+	}
+}
+
+// closest sample of a dense sampling of every segment, and half the largest distance between consecutive samples, which bounds how much farther the
+// closest sample can be than the closest point of the spline
+double projectByDenseSampling(const Simpline::ParametrizedSpline& spline, const std::vector<double>& parameterValues, const Simpline::Vector& point,
+							  double& sampleSpacing)
+{
+	const size_t samplesPerSegment = 500;
+	double closestDistance = std::numeric_limits<double>::infinity();
+	sampleSpacing = 0;
+	Simpline::Vector previousSample = spline.getValue(parameterValues[0]);
+	for(size_t i = 0; i + 1 < parameterValues.size(); i++)
+	{
+		for(size_t j = 0; j <= samplesPerSegment; j++)
+		{
+			const double parameterValue = j == samplesPerSegment ? parameterValues[i + 1] :
+										  parameterValues[i] + (parameterValues[i + 1] - parameterValues[i]) * j / samplesPerSegment;
+			const Simpline::Vector sample = spline.getValue(parameterValue);
+			closestDistance = std::min(closestDistance, (sample - point).norm());
+			sampleSpacing = std::max(sampleSpacing, (sample - previousSample).norm() / 2);
+			previousSample = sample;
+		}
+	}
+	return closestDistance;
+}
+
+// the hierarchy of bounding boxes only prunes segments that cannot hold the closest point, so projections must never be farther than the closest
+// dense sample, including for points next to the knots where the closest point can jump from one segment to the next
+void testProjectionMatchesDenseSampling()
+{
+	for(const unsigned seed: {41u, 43u, 47u})
+	{
+		const size_t pointCount = 80;
+		const std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(pointCount, seed);
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<double> spacingDistribution(0.5, 2);
+		std::normal_distribution<double> offsetDistribution(0, 1);
+		std::vector<double> parameterValues(pointCount, 0);
+		for(size_t i = 1; i < pointCount; i++)
+		{
+			parameterValues[i] = parameterValues[i - 1] + spacingDistribution(generator);
+		}
+		const Simpline::ParametrizedSpline spline(parameterValues, points);
+		
+		// points scattered around the walk, and points close to each knot, to the middle of its neighbours and to the ends
+		std::vector<Simpline::Vector> queriedPoints;
+		for(size_t i = 0; i < 100; i++)
+		{
+			queriedPoints.push_back(points[i % pointCount] + 3 * Simpline::Vector(offsetDistribution(generator), offsetDistribution(generator),
+																					offsetDistribution(generator)));
+		}
+		for(size_t i = 0; i < pointCount; i++)
+		{
+			const Simpline::Vector direction(offsetDistribution(generator), offsetDistribution(generator), offsetDistribution(generator));
+			queriedPoints.push_back(points[i] + 1e-3 * direction);
+			queriedPoints.push_back(points[i] + 0.3 * direction);
+			if(i > 0 && i + 1 < pointCount)
+			{
+				queriedPoints.push_back((points[i - 1] + points[i + 1]) / 2);
+			}
+		}
+		
+		Simpline::SplineCursor cursor;
+		double distanceExcess = 0;
+		double distanceDeficit = 0;
+		double pointError = 0;
+		double cursorDistanceError = 0;
+		for(const Simpline::Vector& queriedPoint: queriedPoints)
+		{
+			double sampleSpacing;
+			const double sampledDistance = projectByDenseSampling(spline, parameterValues, queriedPoint, sampleSpacing);
+			const Simpline::Projection projection = spline.project(queriedPoint);
+			distanceExcess = std::max(distanceExcess, projection.distance - sampledDistance);
+			distanceDeficit = std::max(distanceDeficit, sampledDistance - sampleSpacing - projection.distance);
+			pointError = std::max(pointError, (projection.point - spline.getValue(projection.parameterValue)).norm());
+			pointError = std::max(pointError, std::abs(projection.distance - (projection.point - queriedPoint).norm()));
+			SIMPLINE_CHECK(projection.parameterValue >= parameterValues[0] && projection.parameterValue <= parameterValues[pointCount - 1]);
+			// searching the segment of the previous projection first must not change the result
+			cursorDistanceError = std::max(cursorDistanceError, std::abs(spline.project(queriedPoint, cursor).distance - projection.distance));
+		}
+		SIMPLINE_CHECK(distanceExcess <= 1e-10);
+		SIMPLINE_CHECK(distanceDeficit <= 0);
+		SIMPLINE_CHECK(pointError <= 1e-12);
+		SIMPLINE_CHECK(cursorDistanceError <= 1e-10);
+	}
+}
+
+// a basis sorts and factorizes the knots once for all of its point sets, the splines it creates must be the same as splines built directly from the
+// same parameter values and points, including unsorted ones and the smallest systems
+void testKnotBasisMatchesDirectConstruction()
+{
+	std::mt19937 generator(53);
+	std::uniform_real_distribution<double> spacingDistribution(0.2, 3);
+	for(const size_t pointCount: {2, 3, 4, 17, 1000})
+	{
+		std::vector<double> sortedParameterValues(pointCount, -5);
+		for(size_t i = 1; i < pointCount; i++)
+		{
+			sortedParameterValues[i] = sortedParameterValues[i - 1] + spacingDistribution(generator);
+		}
+		std::vector<double> parameterValues = sortedParameterValues;
+		std::shuffle(parameterValues.begin(), parameterValues.end(), generator);
+		const std::vector<std::vector<Simpline::Vector>> pointSets = {createRandomWalk<double, 3>(pointCount, 55),
+																	  createRandomWalk<double, 3>(pointCount, 57)};
+		
+		const Simpline::KnotBasis basis(parameterValues);
+		SIMPLINE_CHECK(basis.size() == pointCount);
+		const std::vector<Simpline::ParametrizedSpline> basisSplines = basis.createSplines(pointSets);
+		SIMPLINE_CHECK(basisSplines.size() == pointSets.size());
+		for(size_t i = 0; i < pointSets.size(); i++)
+		{
+			const std::vector<double> directFingerprint = getConstructionFingerprint(Simpline::ParametrizedSpline(parameterValues, pointSets[i]),
+																					 sortedParameterValues);
+			for(const Simpline::ParametrizedSpline& spline: {basisSplines[i], Simpline::ParametrizedSpline(basis, pointSets[i])})
+			{
+				const std::vector<double> fingerprint = getConstructionFingerprint(spline, sortedParameterValues);
+				SIMPLINE_CHECK(fingerprint.size() == directFingerprint.size() &&
+							   std::memcmp(fingerprint.data(), directFingerprint.data(), directFingerprint.size() * sizeof(double)) == 0);
+			}
+		}
+		SIMPLINE_CHECK_THROWS(Simpline::ParametrizedSpline(basis, createRandomWalk<double, 3>(pointCount + 1, 59)));
+	}
+	SIMPLINE_CHECK_THROWS(Simpline::KnotBasis({1.0}));
+	SIMPLINE_CHECK_THROWS(Simpline::KnotBasis({1.0, 2.0, 1.0}));
+}
+
+int main()
+{
+	testSolverMatchesDenseSystem();
+	testSolverTwoPoints();
+	testRejectedAppendsLeaveSplineUnchanged();
+	testRejectedReplacementsLeaveSplineUnchanged();
+	testAdaptiveQuadratureErrorEstimates();
+	testAdaptiveQuadratureMatchesFixedRule();
+	testParallelConstructionMatchesSerial();
+	testProjectionMatchesDenseSampling();
+	testKnotBasisMatchesDirectConstruction();
+	return reportFailures();
+}
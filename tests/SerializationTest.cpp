@@ -0,0 +1,176 @@
+#include "TestUtilities.h"
+#include "../simpline/Serialization.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+typedef simpline<double, 3> Simpline;
+
+// the fallback without memory mappings is built as a separate test, which may run at the same time
+#ifdef SIMPLINE_MEMORY_MAPPING
+const std::string fileName = "SerializationTest.spline";
+const std::string corruptedFileName = "SerializationTestCorrupted.spline";
+#else
+const std::string fileName = "SerializationTestWithoutMapping.spline";
+const std::string corruptedFileName = "SerializationTestWithoutMappingCorrupted.spline";
+#endif
+
+std::vector<char> readFile(const std::string& name)
+{
+	std::ifstream file(name, std::ios::binary);
+	return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& name, const std::vector<char>& data)
+{
+	std::ofstream file(name, std::ios::binary | std::ios::trunc);
+	file.write(data.data(), data.size());
+}
+
+simplineInternal::FileHeader readHeader(const std::vector<char>& data)
+{
+	simplineInternal::FileHeader header;
+	std::memcpy(&header, data.data(), sizeof(header));
+	return header;
+}
+
+// the bytes of the saved file with a value overwritten at the given offset
+template<typename Value>
+std::vector<char> corrupt(const std::vector<char>& data, const uint64_t& offset, const Value& value)
+{
+	std::vector<char> corruptedData = data;
+	std::memcpy(corruptedData.data() + offset, &value, sizeof(value));
+	return corruptedData;
+}
+
+void testRoundTrip()
+{
+	const Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(50, 29), 2.0);
+	spline.save(fileName);
+	const Simpline::ConstantSpeedSpline loadedSpline = Simpline::ConstantSpeedSpline::load(fileName);
+	SIMPLINE_CHECK(loadedSpline.getDuration() == spline.getDuration());
+	SIMPLINE_CHECK(loadedSpline.getValue(spline.getDuration() / 3) == spline.getValue(spline.getDuration() / 3));
+}
+
+// the bytes of the saved file with a header value overwritten and the checksum of the header updated, so that the value itself is checked
+template<typename Value>
+std::vector<char> corruptHeader(const std::vector<char>& data, const uint64_t& offset, const Value& value)
+{
+	std::vector<char> corruptedData = corrupt(data, offset, value);
+	const uint64_t checksum = simplineInternal::computeHeaderChecksum(readHeader(corruptedData));
+	return corrupt(corruptedData, offsetof(simplineInternal::FileHeader, headerChecksum), checksum);
+}
+
+// loading only reads the header, headers breaking the invariants of the splines must be rejected
+void testCorruptedHeadersAreRejected()
+{
+	const Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(50, 31), 2.0);
+	spline.save(fileName);
+	const std::vector<char> data = readFile(fileName);
+	const double notANumber = std::numeric_limits<double>::quiet_NaN();
+	
+	std::vector<std::vector<char>> corruptedFiles;
+	// any change of the header without its checksum
+	corruptedFiles.push_back(corrupt(data, offsetof(simplineInternal::FileHeader, duration), spline.getDuration() + 1));
+	corruptedFiles.push_back(corrupt(data, offsetof(simplineInternal::FileHeader, headerChecksum), uint64_t(0)));
+	// point counts beyond the file, including ones whose section sizes overflow
+	corruptedFiles.push_back(corruptHeader(data, offsetof(simplineInternal::FileHeader, pointCount), uint64_t(100)));
+	corruptedFiles.push_back(corruptHeader(data, offsetof(simplineInternal::FileHeader, pointCount), uint64_t(1) << 60));
+	corruptedFiles.push_back(corruptHeader(data, offsetof(simplineInternal::FileHeader, pointCount), uint64_t(1)));
+	corruptedFiles.push_back(corruptHeader(data, offsetof(simplineInternal::FileHeader, segmentsOffset), uint64_t(data.size())));
+	// header scalars of constant-speed splines
+	corruptedFiles.push_back(corruptHeader(data, offsetof(simplineInternal::FileHeader, speed), 0.0));
+	corruptedFiles.push_back(corruptHeader(data, offsetof(simplineInternal::FileHeader, tolerance), notANumber));
+	corruptedFiles.push_back(std::vector<char>(data.begin(), data.end() - 8));
+	
+	for(const std::vector<char>& corruptedData: corruptedFiles)
+	{
+		writeFile(corruptedFileName, corruptedData);
+		SIMPLINE_CHECK_THROWS(Simpline::ConstantSpeedSpline::load(corruptedFileName));
+	}
+	// the unchanged copy still loads
+	writeFile(corruptedFileName, data);
+	SIMPLINE_CHECK(Simpline::ConstantSpeedSpline::load(corruptedFileName).getDuration() == spline.getDuration());
+}
+
+// the tolerances are used as they are by the quadrature, they must meet the same requirements as in the constructors
+void testInvalidQuadratureTolerancesAreRejected()
+{
+	const Simpline::Quadrature quadrature = {Simpline::Quadrature::ADAPTIVE_GAUSS_KRONROD_15, 0, 1e-8};
+	std::vector<double> parameterValues;
+	for(size_t i = 0; i < 30; i++)
+	{
+		parameterValues.push_back(i);
+	}
+	const Simpline::ParametrizedSpline spline(parameterValues, createRandomWalk<double, 3>(30, 37), quadrature);
+	spline.save(fileName);
+	const std::vector<char> data = readFile(fileName);
+	const double notANumber = std::numeric_limits<double>::quiet_NaN();
+	const uint64_t absoluteToleranceOffset = offsetof(simplineInternal::FileHeader, quadratureAbsoluteTolerance);
+	const uint64_t relativeToleranceOffset = offsetof(simplineInternal::FileHeader, quadratureRelativeTolerance);
+	
+	const std::vector<std::vector<char>> corruptedFiles = {corruptHeader(data, absoluteToleranceOffset, notANumber),
+														   corruptHeader(data, absoluteToleranceOffset, -1e-9),
+														   corruptHeader(data, relativeToleranceOffset, notANumber),
+														   corruptHeader(data, relativeToleranceOffset, -1e-8),
+														   corruptHeader(data, relativeToleranceOffset, 0.0)};
+	for(const std::vector<char>& corruptedData: corruptedFiles)
+	{
+		writeFile(corruptedFileName, corruptedData);
+		SIMPLINE_CHECK_THROWS(Simpline::ParametrizedSpline::load(corruptedFileName));
+	}
+	
+	writeFile(corruptedFileName, corruptHeader(data, absoluteToleranceOffset, 1e-9));
+	SIMPLINE_CHECK(Simpline::ParametrizedSpline::load(corruptedFileName).getLength() == spline.getLength());
+}
+
+// the data after the header is only read by validate(), files whose data breaks the invariants of the splines load but do not validate
+void testCorruptedDataIsRejectedByValidation()
+{
+	const Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(50, 31), 2.0);
+	spline.save(fileName);
+	spline.validate();
+	const std::vector<char> data = readFile(fileName);
+	const simplineInternal::FileHeader header = readHeader(data);
+	const double notANumber = std::numeric_limits<double>::quiet_NaN();
+	
+	std::vector<std::vector<char>> corruptedFiles;
+	// parameter values not increasing, repeated, not a number or infinite
+	corruptedFiles.push_back(corrupt(data, header.parameterValuesOffset + 10 * sizeof(double), -1.0));
+	double eleventhParameterValue;
+	std::memcpy(&eleventhParameterValue, data.data() + header.parameterValuesOffset + 10 * sizeof(double), sizeof(double));
+	corruptedFiles.push_back(corrupt(data, header.parameterValuesOffset + 11 * sizeof(double), eleventhParameterValue));
+	corruptedFiles.push_back(corrupt(data, header.parameterValuesOffset + 20 * sizeof(double), notANumber));
+	corruptedFiles.push_back(corrupt(data, header.parameterValuesOffset + 49 * sizeof(double), std::numeric_limits<double>::infinity()));
+	// coefficients and cumulative lengths
+	corruptedFiles.push_back(corrupt(data, header.segmentsOffset + 30 * sizeof(Simpline::SegmentCoefficients) + 5 * sizeof(double), notANumber));
+	corruptedFiles.push_back(corrupt(data, header.cumulativeLengthsOffset + 30 * sizeof(double), -1.0));
+	corruptedFiles.push_back(corrupt(data, header.cumulativeLengthsOffset, 1.0));
+	
+	for(const std::vector<char>& corruptedData: corruptedFiles)
+	{
+		writeFile(corruptedFileName, corruptedData);
+		const Simpline::ConstantSpeedSpline loadedSpline = Simpline::ConstantSpeedSpline::load(corruptedFileName);
+		SIMPLINE_CHECK_THROWS(loadedSpline.validate());
+	}
+	writeFile(corruptedFileName, data);
+	Simpline::ConstantSpeedSpline::load(corruptedFileName).validate();
+	SIMPLINE_CHECK_THROWS(Simpline::ConstantSpeedSpline().validate());
+	SIMPLINE_CHECK_THROWS(Simpline::ParametrizedSpline().validate());
+}
+
+int main()
+{
+	testRoundTrip();
+	testCorruptedHeadersAreRejected();
+	testInvalidQuadratureTolerancesAreRejected();
+	testCorruptedDataIsRejectedByValidation();
+	std::remove(fileName.c_str());
+	std::remove(corruptedFileName.c_str());
+	return reportFailures();
+}
@@ -0,0 +1,112 @@
+#include "TestUtilities.h"
+#include <algorithm>
+#include <vector>
+
+typedef simpline<double, 3> Simpline;
+
+// the cursors of the batch are held across ticks, evaluations at every tick must stay within the tolerance of fresh evaluations of the splines
+void testTicksMatchFreshEvaluations()
+{
+	const double tolerance = 1e-4;
+	std::vector<Simpline::ConstantSpeedSpline> splines;
+	Simpline::SplineBatch batch;
+	for(unsigned i = 0; i < 8; i++)
+	{
+		splines.emplace_back(createRandomWalk<double, 3>(20 + 10 * i, i), 1.0 + 0.25 * i, tolerance);
+		batch.add(splines.back());
+	}
+	// the last spline takes the place of the removed one, its cursor must follow it
+	batch.remove(2);
+	splines[2] = splines.back();
+	splines.pop_back();
+	
+	Simpline::ThreadPool threadPool(2);
+	std::vector<double> values(3 * batch.size());
+	std::vector<double> gradients(3 * batch.size());
+	std::vector<double> parallelValues(3 * batch.size());
+	double valueError = 0;
+	double gradientError = 0;
+	bool parallelValuesMatch = true;
+	for(size_t tick = 0; tick < 40000; tick++)
+	{
+		const double time = tick * 1e-3;
+		batch.evaluate(time, values.data(), gradients.data());
+		// the parallel evaluations use the same cursors, at the next tick
+		batch.evaluate(time + 5e-4, parallelValues.data(), nullptr, threadPool);
+		for(size_t i = 0; i < batch.size(); i++)
+		{
+			const Simpline::ConstantSpeedSpline& spline = splines[i];
+			const double splineTime = std::min(time, spline.getDuration());
+			valueError = std::max(valueError, (Eigen::Map<const Simpline::Vector>(values.data() + 3 * i) - spline.getValue(splineTime)).norm());
+			gradientError = std::max(gradientError, (Eigen::Map<const Simpline::Vector>(gradients.data() + 3 * i) -
+													 spline.getGradient(splineTime)).norm());
+			const double nextSplineTime = std::min(time + 5e-4, spline.getDuration());
+			parallelValuesMatch = parallelValuesMatch &&
+								 (Eigen::Map<const Simpline::Vector>(parallelValues.data() + 3 * i) - spline.getValue(nextSplineTime)).norm() <= 2 * tolerance;
+		}
+	}
+	SIMPLINE_CHECK(valueError <= 2 * tolerance);
+	// unit tangents times the speed, whose error is the one of the parameter value times the curvature and the speed
+	SIMPLINE_CHECK(gradientError <= 3e-2);
+	SIMPLINE_CHECK(parallelValuesMatch);
+}
+
+// splines are evaluated in lanes by blocks, each lane must follow its own quadrature rule, adaptive ones being inverted alone, and keep its segment
+// when splines are removed and added between ticks, times going backward restart the searches
+void testLanesMatchFreshEvaluations()
+{
+	const double tolerance = 1e-6;
+	const Simpline::Quadrature::Rule rules[4] = {Simpline::Quadrature::GAUSS_LEGENDRE_5, Simpline::Quadrature::GAUSS_LEGENDRE_7,
+												 Simpline::Quadrature::GAUSS_LEGENDRE_25, Simpline::Quadrature::ADAPTIVE_GAUSS_KRONROD_15};
+	std::vector<Simpline::ConstantSpeedSpline> splines;
+	for(unsigned i = 0; i < 150; i++)
+	{
+		Simpline::Quadrature quadrature;
+		quadrature.rule = rules[i % 4];
+		splines.emplace_back(createRandomWalk<double, 3>(10 + i % 7, 100 + i), 0.5 + 0.01 * i, tolerance, quadrature);
+	}
+	
+	Simpline::SplineBatch batch;
+	std::vector<size_t> splineIdentifiers;
+	for(const Simpline::ConstantSpeedSpline& spline: splines)
+	{
+		splineIdentifiers.push_back(batch.add(spline));
+	}
+	
+	const double times[8] = {0.0, 0.3, 0.35, 2.0, 1.0, 1.01, 6.0, 100.0};
+	double valueError = 0;
+	double gradientError = 0;
+	for(size_t tick = 0; tick < 8; tick++)
+	{
+		if(tick == 2)
+		{
+			// removals move the last splines in the first blocks, the added spline takes a freed identifier and the row of the last lane
+			batch.remove(splineIdentifiers[5]);
+			batch.remove(splineIdentifiers[70]);
+			batch.remove(splineIdentifiers[149]);
+			splineIdentifiers[5] = batch.add(splines[5]);
+		}
+		
+		std::vector<double> values(3 * batch.size());
+		std::vector<double> gradients(3 * batch.size());
+		batch.evaluate(times[tick], values.data(), gradients.data());
+		for(size_t i = 0; i < batch.size(); i++)
+		{
+			const size_t splineIndex = std::find(splineIdentifiers.begin(), splineIdentifiers.end(), batch.getIdentifiers()[i]) - splineIdentifiers.begin();
+			const Simpline::ConstantSpeedSpline& spline = splines[splineIndex];
+			const double splineTime = std::min(times[tick], spline.getDuration());
+			valueError = std::max(valueError, (Eigen::Map<const Simpline::Vector>(values.data() + 3 * i) - spline.getValue(splineTime)).norm());
+			gradientError = std::max(gradientError, (Eigen::Map<const Simpline::Vector>(gradients.data() + 3 * i) -
+													 spline.getGradient(splineTime)).norm());
+		}
+	}
+	SIMPLINE_CHECK(valueError <= 2 * tolerance);
+	SIMPLINE_CHECK(gradientError <= 1e-3);
+}
+
+int main()
+{
+	testTicksMatchFreshEvaluations();
+	testLanesMatchFreshEvaluations();
+	return reportFailures();
+}
@@ -0,0 +1,146 @@
+#include "TestUtilities.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+typedef simpline<double, 3> Simpline;
+
+// the cursor of a reader belongs to the version it last evaluated, a new version must not be warm started from it
+void testReaderAfterSwap()
+{
+	const double tolerance = 1e-4;
+	std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(40, 17);
+	const Simpline::ConstantSpeedSpline firstSpline(points, 1.0, tolerance);
+	// same segments with slightly different lengths, so that a stale cursor would land in the right segment with the wrong anchor
+	points[3] += Simpline::Vector(0.05, -0.05, 0.05);
+	const Simpline::ConstantSpeedSpline secondSpline(points, 1.0, tolerance);
+	
+	Simpline::SplineHandle handle;
+	Simpline::SplineHandle::Reader reader(handle);
+	Simpline::Vector value;
+	SIMPLINE_CHECK(reader.tryGetValue(0, value) == Simpline::EMPTY_SPLINE);
+	handle.publish(firstSpline, 0);
+	double error = 0;
+	for(size_t i = 0; i < 10000; i++)
+	{
+		SIMPLINE_CHECK(reader.tryGetValue(i * 1e-3, value) == Simpline::SUCCESS);
+		error = std::max(error, (value - firstSpline.getValue(i * 1e-3)).norm());
+	}
+	SIMPLINE_CHECK(reader.getSequenceNumber() == 1);
+	
+	handle.publish(secondSpline, 0);
+	for(size_t i = 10000; i < 20000; i++)
+	{
+		SIMPLINE_CHECK(reader.tryGetValue(i * 1e-3, value) == Simpline::SUCCESS);
+		error = std::max(error, (value - secondSpline.getValue(i * 1e-3)).norm());
+	}
+	SIMPLINE_CHECK(reader.getSequenceNumber() == 2);
+	SIMPLINE_CHECK(error <= 2 * tolerance);
+}
+
+// versions are swapped by another thread while the reader evaluates, each evaluation must match the version it reports
+void testReaderDuringConcurrentSwaps()
+{
+	const double tolerance = 1e-4;
+	std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(40, 19);
+	const Simpline::ConstantSpeedSpline firstSpline(points, 1.0, tolerance);
+	points[5] += Simpline::Vector(-0.05, 0.05, 0.05);
+	const Simpline::ConstantSpeedSpline secondSpline(points, 1.0, tolerance);
+	
+	Simpline::SplineHandle handle;
+	handle.publish(firstSpline, 0);
+	std::atomic<bool> stopping(false);
+	std::thread writer([&]()
+	{
+		// odd sequence numbers are the first spline and even ones the second
+		for(size_t i = 0; i < 200 && !stopping.load(); i++)
+		{
+			handle.publish(i % 2 == 0 ? secondSpline : firstSpline, 0);
+			std::this_thread::yield();
+		}
+	});
+	
+	double error = 0;
+	bool allSucceeded = true;
+	{
+		Simpline::SplineHandle::Reader reader(handle);
+		const double duration = std::min(firstSpline.getDuration(), secondSpline.getDuration());
+		for(size_t i = 0; i * 1e-3 <= duration; i++)
+		{
+			const double time = i * 1e-3;
+			Simpline::Vector value;
+			allSucceeded = allSucceeded && reader.tryGetValue(time, value) == Simpline::SUCCESS;
+			const Simpline::ConstantSpeedSpline& spline = reader.getSequenceNumber() % 2 == 1 ? firstSpline : secondSpline;
+			error = std::max(error, (value - spline.getValue(time)).norm());
+		}
+		stopping.store(true);
+		writer.join();
+	}
+	SIMPLINE_CHECK(allSucceeded);
+	SIMPLINE_CHECK(error <= 2 * tolerance);
+}
+
+// points every step from the start to the end, the end excluded
+void appendLine(std::vector<Simpline::Vector>& points, const Simpline::Vector& start, const Simpline::Vector& end, const double& step)
+{
+	const size_t count = std::round((end - start).norm() / step);
+	for(size_t i = 0; i < count; i++)
+	{
+		points.push_back(start + (end - start) * i / count);
+	}
+}
+
+// a replan sharing the start of the current plan but looping back through the position of the reader must continue from the pass the reader is
+// on, even when the later pass is closer, and replans starting from the reader must still continue from their start
+void testSelfCrossingReplan()
+{
+	std::vector<Simpline::Vector> straightPoints;
+	appendLine(straightPoints, Simpline::Vector(0, 0, 0), Simpline::Vector(10, 0, 0), 0.5);
+	straightPoints.push_back(Simpline::Vector(10, 0, 0));
+	const Simpline::ConstantSpeedSpline straightSpline(straightPoints, 1.0);
+	
+	// the first pass is slightly offset from the reader, the loop comes back down through its position exactly
+	std::vector<Simpline::Vector> loopPoints;
+	appendLine(loopPoints, Simpline::Vector(0, 0.01, 0), Simpline::Vector(10, 0.01, 0), 0.5);
+	appendLine(loopPoints, Simpline::Vector(10, 0.01, 0), Simpline::Vector(10, 4, 0), 0.5);
+	appendLine(loopPoints, Simpline::Vector(10, 4, 0), Simpline::Vector(3, 4, 0), 0.5);
+	appendLine(loopPoints, Simpline::Vector(3, 4, 0), Simpline::Vector(3, -4, 0), 0.5);
+	loopPoints.push_back(Simpline::Vector(3, -4, 0));
+	const Simpline::ConstantSpeedSpline loopSpline(loopPoints, 1.0);
+	SIMPLINE_CHECK(loopSpline.project(Simpline::Vector(3, 0, 0)).time > 20);
+	
+	Simpline::SplineHandle handle;
+	Simpline::SplineHandle::Reader reader(handle);
+	handle.publish(straightSpline, 0);
+	Simpline::Vector value;
+	for(size_t i = 0; i <= 30; i++)
+	{
+		reader.tryGetValue(i * 0.1, value);
+	}
+	handle.publish(loopSpline);
+	// the arc length of the first pass up to the reader is the one of the current plan, the start time stays the same
+	SIMPLINE_CHECK(std::abs(handle.getStartTime()) <= 1e-3);
+	Simpline::Vector nextValue;
+	SIMPLINE_CHECK(reader.tryGetValue(3.1, nextValue) == Simpline::SUCCESS);
+	SIMPLINE_CHECK((nextValue - Simpline::Vector(3.1, 0.01, 0)).norm() <= 1e-3);
+	
+	// a replan starting from the reader has no pass near the arc length reached on the current plan
+	std::vector<Simpline::Vector> detourPoints;
+	appendLine(detourPoints, Simpline::Vector(3.1, 0.01, 0), Simpline::Vector(3.1, 10, 0), 0.1);
+	detourPoints.push_back(Simpline::Vector(3.1, 10, 0));
+	const Simpline::ConstantSpeedSpline detourSpline(detourPoints, 1.0);
+	handle.publish(detourSpline);
+	SIMPLINE_CHECK(std::abs(handle.getStartTime() - 3.1) <= 1e-3);
+	SIMPLINE_CHECK(reader.tryGetValue(3.2, nextValue) == Simpline::SUCCESS);
+	SIMPLINE_CHECK((nextValue - Simpline::Vector(3.1, 0.11, 0)).norm() <= 1e-3);
+}
+
+int main()
+{
+	testReaderAfterSwap();
+	testReaderDuringConcurrentSwaps();
+	testSelfCrossingReplan();
+	return reportFailures();
+}
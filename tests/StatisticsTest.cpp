@@ -0,0 +1,183 @@
+#include "TestUtilities.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+// compiled with SIMPLINE_ENABLE_STATISTICS, without which the counters are compiled out and this test has nothing to check
+#ifndef SIMPLINE_ENABLE_STATISTICS
+#error "The statistics test must be compiled with SIMPLINE_ENABLE_STATISTICS."
+#endif
+
+typedef simpline<double, 3> Simpline;
+
+Simpline::Statistics subtract(const Simpline::Statistics& statistics, const Simpline::Statistics& previousStatistics)
+{
+	Simpline::Statistics difference = statistics;
+	difference.evaluationCount -= previousStatistics.evaluationCount;
+	difference.segmentSearchCount -= previousStatistics.segmentSearchCount;
+	difference.scannedSegmentCount -= previousStatistics.scannedSegmentCount;
+	difference.rootFindingCount -= previousStatistics.rootFindingCount;
+	difference.rootFindingIterationCount -= previousStatistics.rootFindingIterationCount;
+	difference.quadratureCount -= previousStatistics.quadratureCount;
+	difference.gradientEvaluationCount -= previousStatistics.gradientEvaluationCount;
+	return difference;
+}
+
+bool haveSameCounters(const Simpline::Statistics& first, const Simpline::Statistics& second)
+{
+	return first.evaluationCount == second.evaluationCount && first.segmentSearchCount == second.segmentSearchCount &&
+		   first.scannedSegmentCount == second.scannedSegmentCount && first.rootFindingCount == second.rootFindingCount &&
+		   first.rootFindingIterationCount == second.rootFindingIterationCount && first.quadratureCount == second.quadratureCount &&
+		   first.gradientEvaluationCount == second.gradientEvaluationCount;
+}
+
+// a fixed rule integrates each segment once with a fixed number of gradient evaluations, and evaluations without a cursor do one binary search
+void testCountersOfKnownOperations()
+{
+	const size_t pointCount = 100;
+	std::vector<double> parameterValues(pointCount);
+	for(size_t i = 0; i < pointCount; i++)
+	{
+		parameterValues[i] = i;
+	}
+	const Simpline::ParametrizedSpline spline(parameterValues, createRandomWalk<double, 3>(pointCount, 61));
+	const Simpline::Statistics constructionStatistics = spline.getStatistics();
+	SIMPLINE_CHECK(constructionStatistics.evaluationCount == 0);
+	SIMPLINE_CHECK(constructionStatistics.quadratureCount == pointCount - 1);
+	SIMPLINE_CHECK(constructionStatistics.gradientEvaluationCount == 25 * (pointCount - 1));
+	SIMPLINE_CHECK(constructionStatistics.rootFindingCount == 0);
+	SIMPLINE_CHECK(constructionStatistics.solvingTime > 0 && constructionStatistics.lengthIntegrationTime > 0);
+	
+	for(size_t i = 0; i < 10; i++)
+	{
+		spline.getValue(i * 9.5);
+	}
+	Simpline::Statistics statistics = subtract(spline.getStatistics(), constructionStatistics);
+	SIMPLINE_CHECK(statistics.evaluationCount == 10);
+	SIMPLINE_CHECK(statistics.segmentSearchCount == 10);
+	SIMPLINE_CHECK(statistics.scannedSegmentCount == 10 * simplineInternal::countBinarySearchComparisons(pointCount));
+	SIMPLINE_CHECK(statistics.quadratureCount == 0 && statistics.rootFindingCount == 0);
+	
+	// a batch is one evaluation, whatever the number of values
+	const Simpline::Statistics previousStatistics = spline.getStatistics();
+	std::vector<double> values(3 * parameterValues.size());
+	spline.evaluate(parameterValues.data(), parameterValues.size(), values.data(), nullptr);
+	statistics = subtract(spline.getStatistics(), previousStatistics);
+	SIMPLINE_CHECK(statistics.evaluationCount == 1);
+	SIMPLINE_CHECK(statistics.segmentSearchCount > 0);
+	
+	// the length up to a parameter value integrates one partial segment
+	const Simpline::Statistics lengthStatistics = spline.getStatistics();
+	spline.getLength(0, 42.5);
+	statistics = subtract(spline.getStatistics(), lengthStatistics);
+	SIMPLINE_CHECK(statistics.evaluationCount == 1);
+	SIMPLINE_CHECK(statistics.quadratureCount >= 1 && statistics.gradientEvaluationCount == 25 * statistics.quadratureCount);
+}
+
+// an evaluation of a constant-speed spline evaluates its parametrized spline within its own scope, the statistics of both are added, so work
+// counted by both scopes would be counted twice, and trace events must add up to the statistics
+void testNestedScopesAndTraceEvents()
+{
+	Simpline::ConstantSpeedSpline spline(createRandomWalk<double, 3>(50, 63), 1.0);
+	const Simpline::Statistics previousStatistics = spline.getStatistics();
+	
+	Simpline::Statistics tracedStatistics;
+	size_t eventCount = 0;
+	bool allNamed = true;
+	spline.setTraceCallback([&](const Simpline::TraceEvent& event)
+	{
+		tracedStatistics += event.statistics;
+		eventCount++;
+		allNamed = allNamed && event.operation && std::string(event.operation) == "getValue";
+	});
+	// times within the segments, inversions at their ends return without root finding
+	const size_t evaluationCount = 20;
+	for(size_t i = 0; i < evaluationCount; i++)
+	{
+		spline.getValue(spline.getDuration() * (i + 0.5) / evaluationCount);
+	}
+	spline.setTraceCallback(Simpline::TraceCallback());
+	
+	const Simpline::Statistics statistics = subtract(spline.getStatistics(), previousStatistics);
+	SIMPLINE_CHECK(statistics.evaluationCount == evaluationCount);
+	SIMPLINE_CHECK(statistics.rootFindingCount == evaluationCount);
+	SIMPLINE_CHECK(statistics.rootFindingIterationCount >= statistics.rootFindingCount);
+	SIMPLINE_CHECK(statistics.quadratureCount == statistics.rootFindingIterationCount);
+	// the search of the arc length and the one of the parameter value
+	SIMPLINE_CHECK(statistics.segmentSearchCount == 2 * evaluationCount);
+	SIMPLINE_CHECK(eventCount == evaluationCount && allNamed);
+	SIMPLINE_CHECK(haveSameCounters(tracedStatistics, statistics));
+}
+
+// counters are thread-local and added to the spline by the scopes of each thread, concurrent evaluations must add up to the same counts as serial
+// ones, and parallel batches to the same counts as serial batches apart from one evaluation per chunk
+void testCountersAcrossThreads()
+{
+	const std::vector<Simpline::Vector> points = createRandomWalk<double, 3>(200, 65);
+	const Simpline::ConstantSpeedSpline serialSpline(points, 1.0);
+	const Simpline::ConstantSpeedSpline concurrentSpline(points, 1.0);
+	SIMPLINE_CHECK(haveSameCounters(serialSpline.getStatistics(), concurrentSpline.getStatistics()));
+	const Simpline::Statistics constructionStatistics = serialSpline.getStatistics();
+	
+	const size_t threadCount = 4;
+	const size_t evaluationCount = 2000;
+	const auto evaluateAll = [&evaluationCount](const Simpline::ConstantSpeedSpline& spline)
+	{
+		for(size_t i = 0; i < evaluationCount; i++)
+		{
+			spline.getValue(spline.getDuration() * i / evaluationCount);
+		}
+	};
+	evaluateAll(serialSpline);
+	const Simpline::Statistics serialStatistics = subtract(serialSpline.getStatistics(), constructionStatistics);
+	
+	std::vector<std::thread> threads;
+	for(size_t i = 0; i < threadCount; i++)
+	{
+		threads.emplace_back(evaluateAll, std::cref(concurrentSpline));
+	}
+	for(std::thread& thread: threads)
+	{
+		thread.join();
+	}
+	const Simpline::Statistics concurrentStatistics = subtract(concurrentSpline.getStatistics(), constructionStatistics);
+	Simpline::Statistics expectedStatistics;
+	for(size_t i = 0; i < threadCount; i++)
+	{
+		expectedStatistics += serialStatistics;
+	}
+	SIMPLINE_CHECK(haveSameCounters(concurrentStatistics, expectedStatistics));
+	
+	// batches reset their cursor at the same chunk boundaries whether they are split between threads or not
+	const size_t count = 5 * simplineInternal::parallelChunkSize + 17;
+	std::vector<double> times(count);
+	for(size_t i = 0; i < count; i++)
+	{
+		times[i] = serialSpline.getDuration() * i / count;
+	}
+	std::vector<double> values(3 * count);
+	const Simpline::Statistics previousSerialStatistics = serialSpline.getStatistics();
+	serialSpline.evaluate(times.data(), count, values.data(), nullptr);
+	Simpline::Statistics serialBatchStatistics = subtract(serialSpline.getStatistics(), previousSerialStatistics);
+	
+	const Simpline::Statistics previousConcurrentStatistics = concurrentSpline.getStatistics();
+	Simpline::ThreadPool threadPool(threadCount);
+	concurrentSpline.evaluate(times.data(), count, values.data(), nullptr, threadPool);
+	const Simpline::Statistics parallelBatchStatistics = subtract(concurrentSpline.getStatistics(), previousConcurrentStatistics);
+	SIMPLINE_CHECK(serialBatchStatistics.evaluationCount == 1);
+	SIMPLINE_CHECK(parallelBatchStatistics.evaluationCount == 6);
+	serialBatchStatistics.evaluationCount = parallelBatchStatistics.evaluationCount;
+	SIMPLINE_CHECK(haveSameCounters(parallelBatchStatistics, serialBatchStatistics));
+	
+	// parallel constructions count the segments integrated by every thread
+	const Simpline::ConstantSpeedSpline parallelSpline(points, 1.0, 1e-6, Simpline::Quadrature(), threadPool);
+	SIMPLINE_CHECK(haveSameCounters(parallelSpline.getStatistics(), constructionStatistics));
+}
+
+int main()
+{
+	testCountersOfKnownOperations();
+	testNestedScopesAndTraceEvents();
+	testCountersAcrossThreads();
+	return reportFailures();
+}
@@ -0,0 +1,68 @@
+#ifndef SIMPLINE_TEST_UTILITIES_H
+#define SIMPLINE_TEST_UTILITIES_H
+
+#include "../simpline/Simpline.h"
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// failed checks are reported and counted instead of aborting, so that a run lists all of them, the test executable returns the count
+static size_t failureCount = 0;
+
+#define SIMPLINE_CHECK(condition) checkCondition(condition, #condition, __FILE__, __LINE__)
+
+#define SIMPLINE_CHECK_THROWS(statement) checkThrows([&]() { statement; }, #statement, __FILE__, __LINE__)
+
+inline void checkCondition(const bool& condition, const char* expression, const char* fileName, const int& line)
+{
+	if(!condition)
+	{
+		std::cerr << fileName << ":" << line << ": check failed: " << expression << std::endl;
+		failureCount++;
+	}
+}
+
+inline void checkThrows(const std::function<void()>& statement, const char* expression, const char* fileName, const int& line)
+{
+	try
+	{
+		statement();
+	}
+	catch(const std::runtime_error&)
+	{
+		return;
+	}
+	std::cerr << fileName << ":" << line << ": no exception thrown by: " << expression << std::endl;
+	failureCount++;
+}
+
+inline int reportFailures()
+{
+	if(failureCount > 0)
+	{
+		std::cerr << failureCount << " check(s) failed." << std::endl;
+	}
+	return failureCount > 0 ? 1 : 0;
+}
+
+// random walk with normally distributed steps, whose sharp turns are the hardest case of the arc length inversion
+template<typename T, int Dim>
+std::vector<typename simpline<T, Dim>::Vector> createRandomWalk(const size_t& pointCount, const unsigned& seed)
+{
+	std::mt19937 generator(seed);
+	std::normal_distribution<T> stepDistribution(0, 1);
+	std::vector<typename simpline<T, Dim>::Vector> points(pointCount);
+	points[0].setZero();
+	for(size_t i = 1; i < pointCount; i++)
+	{
+		for(int j = 0; j < Dim; j++)
+		{
+			points[i][j] = points[i - 1][j] + stepDistribution(generator);
+		}
+	}
+	return points;
+}
+
+#endif